@@ -0,0 +1,178 @@
+// Times full legal-move enumeration over positions reached by random play:
+// every card against every pile with the branchy checks the follower tables
+// replaced and through the tables themselves, the packed target masks, and
+// generate_moves.
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "game.h"
+#include "move_generator.h"
+
+/// @brief is_valid_placement as it was before the follower tables: compares
+/// suits and values of the moved card and the top of the pile
+static bool branchy_placement(const board& b, const pile& p, card_id c)
+{
+  if (c >= CARDS_COUNT)
+  {
+    return false;
+  }
+  if (p.type == pile_type::foundation &&
+      type_of(b.cards[c].owner) != pile_type::deck &&
+      b.get_child(c) != NO_CARD)
+  {
+    return false;
+  }
+
+  const auto moved = card::from_id(c);
+  if (p.is_empty())
+  {
+    switch (p.type)
+    {
+      case pile_type::tableau:
+        return moved.get_value() == card_value::King;
+      case pile_type::foundation:
+        return moved.get_value() == card_value::Ace;
+      default:
+        break;
+    }
+    return false;
+  }
+
+  const auto top = card::from_id(p.get_last());
+  const auto top_value = static_cast<uint8_t>(top.get_value());
+  const auto moved_value = static_cast<uint8_t>(moved.get_value());
+  switch (p.type)
+  {
+    case pile_type::tableau:
+      if (moved.get_value() != card_value::Ace &&
+          !is_same_color(top.get_suit(), moved.get_suit()))
+      {
+        return top_value - 1 == moved_value;
+      }
+      break;
+
+    case pile_type::foundation:
+      if (top.get_suit() == moved.get_suit())
+      {
+        return top_value + 1 == moved_value;
+      }
+      break;
+
+    default:
+      break;
+  }
+  return false;
+}
+
+/// @brief Runs body over every position repeats times
+/// @return Nanoseconds per position
+template <typename Body>
+static double time_per_position(const std::vector<board>& positions,
+                                 int repeats, Body&& body)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < repeats; r++)
+  {
+    for (const auto& b : positions)
+    {
+      body(b);
+    }
+  }
+  const std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / (static_cast<double>(repeats) * positions.size());
+}
+
+int main()
+{
+  std::mt19937 rng(42);
+  std::vector<board> positions;
+  game g;
+  for (int deal = 0; deal < 64; deal++)
+  {
+    g.new_game(deal);
+    for (int step = 0; step < 64; step++)
+    {
+      positions.push_back(g.snapshot());
+
+      move_list moves;
+      generate_moves(g.get_board(), moves);
+      if (moves.empty())
+      {
+        break;
+      }
+      const auto& m = moves[static_cast<uint8_t>(rng() % moves.count)];
+      if (m.is_stock_advance())
+      {
+        g.next_deck();
+      }
+      else
+      {
+        g.move_card(m.moved_card, m.to_pile);
+      }
+    }
+  }
+
+  constexpr int REPEATS = 200;
+  uint64_t sink = 0;
+
+  const double branchy = time_per_position(
+      positions, REPEATS,
+      [&](const board& b)
+      {
+        for (pile_id p = FIRST_TABLEAU_PILE; p < PILE_COUNT; p++)
+        {
+          for (card_id c = 0; c < CARDS_COUNT; c++)
+          {
+            sink += branchy_placement(b, b.get_pile(p), c);
+          }
+        }
+      });
+
+  const double placements = time_per_position(
+      positions, REPEATS,
+      [&](const board& b)
+      {
+        for (pile_id p = FIRST_TABLEAU_PILE; p < PILE_COUNT; p++)
+        {
+          for (card_id c = 0; c < CARDS_COUNT; c++)
+          {
+            sink += b.is_valid_placement(b.get_pile(p), c);
+          }
+        }
+      });
+
+  const double masks = time_per_position(
+      positions, REPEATS,
+      [&](const board& b)
+      {
+        for (card_id c = 0; c < CARDS_COUNT; c++)
+        {
+          sink += target_mask(b.tops, c);
+        }
+      });
+
+  move_list moves;
+  const double generation = time_per_position(
+      positions, REPEATS,
+      [&](const board& b)
+      {
+        generate_moves(b, moves);
+        sink += moves.count;
+      });
+
+  std::printf("%zu positions, %d repeats\n", positions.size(), REPEATS);
+  std::printf("branchy checks, every card and pile:     %8.1f ns/position\n",
+              branchy);
+  std::printf("is_valid_placement, every card and pile: %8.1f ns/position\n",
+              placements);
+  std::printf("target_mask, every card:                 %8.1f ns/position\n",
+              masks);
+  std::printf("generate_moves:                          %8.1f ns/position\n",
+              generation);
+  std::printf("(checksum %llu)\n", static_cast<unsigned long long>(sink));
+  return 0;
+}
@@ -0,0 +1,71 @@
+// Times solver proofs of hard deals with 1, 2, 4... threads, up to the
+// hardware threads. Every deal listed is lost, so each solve searches the
+// whole tree and the work stays the same whatever the thread count.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "game.h"
+#include "solver.h"
+
+/// @brief Deal and draw count of a hard position
+struct hard_deal
+{
+  uint64_t deal_number;
+  uint8_t draw_count;
+};
+
+// lost deals needing 100 000 to 500 000 nodes with one thread
+static constexpr hard_deal HARD_DEALS[] = {
+    {39596, 3},  {419708, 3}, {427627, 3},
+    {483060, 3}, {578088, 3}, {483060, 1},
+};
+
+int main()
+{
+  const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<uint32_t> thread_counts;
+  for (uint32_t threads = 1; threads <= std::max(4u, hardware); threads *= 2)
+  {
+    thread_counts.push_back(threads);
+  }
+
+  std::printf("%u hardware threads\n", hardware);
+  std::printf("threads   wall ms   nodes      speedup\n");
+
+  double single = 0;
+  game g;
+  for (const auto threads : thread_counts)
+  {
+    solver s(solver_limits{.max_nodes = 4'000'000, .threads = threads});
+    uint64_t nodes = 0;
+    int undecided = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& [deal_number, draw_count] : HARD_DEALS)
+    {
+      g.set_stock_rules(stock_rules{.draw_count = draw_count});
+      g.new_game(deal_number);
+      undecided += s.solve(g.get_board()) != solve_result::unwinnable;
+      nodes += s.get_nodes();
+    }
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    if (threads == 1)
+    {
+      single = elapsed.count();
+    }
+    std::printf("%7u %9.0f %9llu %9.2fx\n", threads, elapsed.count(),
+                static_cast<unsigned long long>(nodes),
+                single / elapsed.count());
+    if (undecided > 0)
+    {
+      std::printf("        %d deals not proved lost\n", undecided);
+    }
+  }
+  return 0;
+}
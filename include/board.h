@@ -0,0 +1,172 @@
+#pragma once
+#include <array>
+#include <type_traits>
+
+#include "card.h"
+#include "card_set.h"
+#include "pile.h"
+#include "placement.h"
+#include "stock_rules.h"
+#include "target_mask.h"
+
+/// @brief Complete card layout of a game. Cards and piles refer to each other
+/// only by index, so a board is a plain value that can be copied with memcpy.
+struct board
+{
+  board() noexcept;
+
+  /// @brief Detaches every card from its pile.
+  void reset() noexcept;
+
+  pile& get_pile(pile_id id) noexcept;
+  const pile& get_pile(pile_id id) const noexcept;
+
+  /// @return Card directly below c in its pile, NO_CARD if c is first
+  card_id get_parent(card_id c) const noexcept;
+
+  /// @return Card directly above c in its pile, NO_CARD if c is last
+  card_id get_child(card_id c) const noexcept;
+
+  /// @brief Checks if c may be placed on p. Only the top card of a tableau may
+  /// go to a foundation.
+  bool is_valid_placement(const pile& p, card_id c) const noexcept
+  {
+    return c < CARDS_COUNT &&
+           valid_followers(p.type, p.get_last()).contains(c) &&
+           (p.type != pile_type::foundation ||
+            type_of(cards[c].owner) == pile_type::deck ||
+            get_child(c) == NO_CARD);
+  }
+
+  /// @brief Adds a card without owner to the end of pile p
+  void place(card_id c, pile& p) noexcept;
+
+  /// @brief Moves c and the cards above it to position in pile to. Deck cards
+  /// are moved alone.
+  void splice(card_id c, pile& to) noexcept;
+  void splice(card_id c, pile& to, uint8_t position) noexcept;
+
+  /// @brief Turns card c face up or down
+  void set_face_up(card_id c, bool up) noexcept;
+
+  /// @return Playable deck card, the last one dealt to the waste, NO_CARD if
+  /// the waste is empty
+  card_id waste_top() const noexcept
+  {
+    return waste_size ? deck.at(waste_size - 1) : NO_CARD;
+  }
+
+  /// @return true if c lies in the deck below the stock
+  bool is_in_waste(card_id c) const noexcept
+  {
+    return cards[c].owner == DECK_PILE && cards[c].position < waste_size;
+  }
+
+  /// @return true if another pass through the stock is allowed after the
+  /// current one
+  bool has_pass_left() const noexcept
+  {
+    return stock.pass_limit == UNLIMITED_PASSES ||
+           passes + 1 < stock.pass_limit;
+  }
+
+  /// @return true if the stock can deal cards or be turned over again
+  bool can_advance_stock() const noexcept
+  {
+    return waste_size < deck.get_height() ||
+           (!deck.is_empty() && has_pass_left());
+  }
+
+  /// @brief Moves the boundary between waste and stock, turning only the new
+  /// waste top face up
+  void set_waste_size(uint8_t size) noexcept;
+
+  /// @brief Changes the number of times the waste was turned over
+  void set_passes(uint8_t count) noexcept;
+
+  /// @return Deck cursor: waste size in the low DECK_CURSOR_PASS_SHIFT bits,
+  /// passes above
+  uint16_t get_deck_cursor() const noexcept
+  {
+    return waste_size | passes << DECK_CURSOR_PASS_SHIFT;
+  }
+
+  /// @brief Restores a cursor from get_deck_cursor
+  void set_deck_cursor(uint16_t cursor) noexcept
+  {
+    set_waste_size(cursor & ((1u << DECK_CURSOR_PASS_SHIFT) - 1));
+    set_passes(cursor >> DECK_CURSOR_PASS_SHIFT);
+  }
+
+  static constexpr uint8_t DECK_CURSOR_PASS_SHIFT = 5;
+
+  /// @brief Recomputes the position hash from scratch
+  uint64_t compute_hash() const noexcept;
+
+  /// @return Hash that ignores the order of the tableau columns and of the
+  /// foundations, which play identical roles: positions that differ only by
+  /// which column or foundation holds what share it. Swapping the two suits
+  /// of a colour is not folded: from one deal the search reaches almost no
+  /// such pairs, and the extra hashing slowed it by a quarter
+  uint64_t canonical_hash() const noexcept;
+
+  std::array<card, CARDS_COUNT> cards;
+
+  std::array<pile, TABLEAU_COUNT> tableaus;
+
+  std::array<pile, FOUNDATION_COUNT> foundations;
+
+  /// @brief Deck in dealing order: the waste below waste_size, the stock
+  /// from there up, its next card first
+  pile deck{pile_type::deck, 0};
+
+  /// @brief Deck cards dealt and not yet turned back into the stock
+  uint8_t waste_size = 0;
+
+  /// @brief Times the waste was turned over into the stock. Only counted
+  /// when passes are limited.
+  uint8_t passes = 0;
+
+  /// @brief Kept across reset
+  stock_rules stock;
+
+  /// @brief Cards showing their face
+  card_set face_up;
+
+  /// @brief Cards resting on any foundation
+  card_set in_foundation;
+
+  /// @brief Cards of every pile, indexed by pile_id
+  std::array<card_set, PILE_COUNT> pile_contents;
+
+  /// @brief Tableau and foundation tops packed for target_mask
+  target_tops tops;
+
+  /// @brief Deck cards that become the waste top by advancing the stock
+  /// alone, in this pass or a later one, the current top included. Other
+  /// deck cards come up only after a waste card is played, which refreshes
+  /// this set. Kept in sync whenever the deck or the waste cursor changes.
+  card_set reachable_stock;
+
+  /// @brief Zobrist hash of the position, kept in sync by the member
+  /// functions above
+  uint64_t hash = 0;
+
+  /// @brief Hash of the cards, positions and faces of each pile, indexed by
+  /// pile_id. Unlike hash it does not depend on which pile holds the cards.
+  std::array<uint64_t, PILE_COUNT> content_hash{};
+
+ private:
+  /// @brief Refreshes owner and position of cards from position upwards, and
+  /// the packed top of p
+  void update_positions(const pile& p, uint8_t position) noexcept;
+
+  /// @brief Recomputes reachable_stock from the deck and the waste cursor
+  void update_reachable_stock() noexcept;
+};
+
+static_assert(PILE_CAPACITY < 1u << board::DECK_CURSOR_PASS_SHIFT,
+              "waste size must fit below the pass count");
+
+static_assert(std::is_trivially_copyable_v<board>,
+              "board must stay copyable with memcpy");
@@ -11,7 +11,7 @@ enum class card_suit : uint8_t
   Diamonds,
 };
 
-inline bool is_same_color(card_suit a, card_suit b)
+constexpr bool is_same_color(card_suit a, card_suit b)
 {
   bool a_red = (a == card_suit::Hearths || a == card_suit::Diamonds);
   bool b_red = (b == card_suit::Hearths || b == card_suit::Diamonds);
@@ -44,23 +44,34 @@ class card
   card(const card&) = default;
   card& operator=(const card&) = default;
 
+  /// @brief Card of the given id, ids of every deck copy map to the same card
+  static constexpr card from_id(card_id id) noexcept
+  {
+    const auto face = id % (COLOR_COUNT * VALUE_COUNT);
+    return card(static_cast<card_suit>(face / VALUE_COUNT),
+                static_cast<card_value>(face % VALUE_COUNT + 1));
+  }
+
   constexpr card_suit get_suit() const noexcept { return _suite; }
   constexpr card_value get_value() const noexcept { return _value; }
-  card* get_parent() const noexcept;
-  
+  constexpr card_id get_id() const noexcept
+  {
+    return static_cast<uint8_t>(_suite) * VALUE_COUNT +
+           static_cast<uint8_t>(_value) - 1;
+  }
+
   /// @brief Checks if other is valid for the next card
   /// @param other Card to be tested
-  bool is_valid_placement(const card& other) const;
-  bool is_valid_placement(const card* other) const;
+  /// @param type Type of pile this card is the top of
+  bool is_valid_placement(const card& other, pile_type type) const;
 
   void reset() noexcept;
 
  public:
-  card* next = nullptr;
-  pile* owner = nullptr;
-  bool face_up = false;
+  pile_id owner = NO_PILE;
+  uint8_t position = 0;
 
  private:
   card_suit _suite;
   card_value _value;
-};
\ No newline at end of file
+};
@@ -0,0 +1,169 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "constants.h"
+
+/// @brief Set of cards stored as a bitmask indexed by card_id, one 64-bit
+/// word per 64 cards so multi-deck variants keep the same operations
+template <size_t N>
+class basic_card_set
+{
+ public:
+  static constexpr size_t WORD_COUNT = (N + 63) / 64;
+
+  constexpr basic_card_set() noexcept = default;
+  constexpr explicit basic_card_set(uint64_t bits) noexcept
+    requires(WORD_COUNT == 1)
+      : _words{bits}
+  {
+  }
+
+  static constexpr basic_card_set of(card_id c) noexcept
+  {
+    basic_card_set s;
+    s.insert(c);
+    return s;
+  }
+
+  /// @return Set holding every card of the deck
+  static constexpr basic_card_set all() noexcept
+  {
+    basic_card_set s;
+    s._words.fill(~uint64_t{0});
+    if constexpr (N % 64 != 0)
+    {
+      s._words[WORD_COUNT - 1] = (uint64_t{1} << N % 64) - 1;
+    }
+    return s;
+  }
+
+  /// @return Set holding the VALUE_COUNT cards of one suit in every deck
+  static constexpr basic_card_set suit(uint8_t color) noexcept
+  {
+    basic_card_set s;
+    for (size_t deck = 0; deck < N; deck += COLOR_COUNT * VALUE_COUNT)
+    {
+      for (uint8_t v = 0; v < VALUE_COUNT; v++)
+      {
+        s.insert(static_cast<card_id>(deck + color * VALUE_COUNT + v));
+      }
+    }
+    return s;
+  }
+
+  constexpr bool contains(card_id c) const noexcept
+  {
+    return (_words[c / 64] >> c % 64) & 1;
+  }
+
+  constexpr void insert(card_id c) noexcept
+  {
+    _words[c / 64] |= uint64_t{1} << c % 64;
+  }
+  constexpr void erase(card_id c) noexcept
+  {
+    _words[c / 64] &= ~(uint64_t{1} << c % 64);
+  }
+  constexpr void clear() noexcept { _words.fill(0); }
+
+  constexpr bool empty() const noexcept
+  {
+    for (const auto w : _words)
+    {
+      if (w != 0)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  constexpr uint8_t size() const noexcept
+  {
+    size_t count = 0;
+    for (const auto w : _words)
+    {
+      count += std::popcount(w);
+    }
+    return static_cast<uint8_t>(count);
+  }
+  constexpr uint64_t bits() const noexcept
+    requires(WORD_COUNT == 1)
+  {
+    return _words[0];
+  }
+
+  /// @return Lowest card id in the set, NO_CARD if the set is empty
+  constexpr card_id first() const noexcept
+  {
+    for (size_t i = 0; i < WORD_COUNT; i++)
+    {
+      if (_words[i] != 0)
+      {
+        return static_cast<card_id>(i * 64 + std::countr_zero(_words[i]));
+      }
+    }
+    return NO_CARD;
+  }
+
+  /// @brief Removes the lowest card id from a non-empty set and returns it
+  constexpr card_id pop_first() noexcept
+  {
+    size_t i = 0;
+    while (_words[i] == 0)
+    {
+      i++;
+    }
+    const auto c = static_cast<card_id>(i * 64 + std::countr_zero(_words[i]));
+    _words[i] &= _words[i] - 1;
+    return c;
+  }
+
+  constexpr basic_card_set operator|(basic_card_set other) const noexcept
+  {
+    return other |= *this;
+  }
+  constexpr basic_card_set operator&(basic_card_set other) const noexcept
+  {
+    return other &= *this;
+  }
+  constexpr basic_card_set operator~() const noexcept
+  {
+    auto s = all();
+    for (size_t i = 0; i < WORD_COUNT; i++)
+    {
+      s._words[i] &= ~_words[i];
+    }
+    return s;
+  }
+  constexpr basic_card_set& operator|=(basic_card_set other) noexcept
+  {
+    for (size_t i = 0; i < WORD_COUNT; i++)
+    {
+      _words[i] |= other._words[i];
+    }
+    return *this;
+  }
+  constexpr basic_card_set& operator&=(basic_card_set other) noexcept
+  {
+    for (size_t i = 0; i < WORD_COUNT; i++)
+    {
+      _words[i] &= other._words[i];
+    }
+    return *this;
+  }
+  constexpr bool operator==(const basic_card_set&) const noexcept = default;
+
+ private:
+  std::array<uint64_t, WORD_COUNT> _words{};
+};
+
+/// @brief Card set of the variant the game is built for
+using card_set = basic_card_set<CARDS_COUNT>;
+
+static_assert(sizeof(card_set) == sizeof(uint64_t),
+              "a single-deck card_set is one word");
+static_assert(basic_card_set<4 * COLOR_COUNT * VALUE_COUNT>::all().size() ==
+              4 * COLOR_COUNT * VALUE_COUNT);
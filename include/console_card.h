@@ -154,11 +154,11 @@ inline std::string to_string_char(const card& card)
                      to_string_char(card.get_value()));
 }
 
-inline void print_card(const card& card)
+inline void print_card(const card& card, bool face_up)
 {
   std::cout << std::format("{}{} {} {}", to_string_emoji(card.get_suit()),
                            to_string(card.get_suit()),
                            to_string(card.get_value()),
-                           card.face_up ? "Visible" : "Hidden")
+                           face_up ? "Visible" : "Hidden")
             << std::endl;
 }
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+
+#include "variant.h"
+
+constexpr uint8_t TABLEAU_COUNT = game_rules::tableau_count;
+constexpr uint8_t FOUNDATION_COUNT = game_rules::foundation_count;
+constexpr uint8_t CARDS_COUNT = game_rules::cards_count;
+
+/// @brief Identity of a card: suit * VALUE_COUNT + (value - 1)
+using card_id = uint8_t;
+
+/// @brief Index of a pile on the board: deck, tableaus, then foundations
+using pile_id = uint8_t;
+
+constexpr card_id NO_CARD = 0xFF;
+constexpr pile_id NO_PILE = 0xFF;
+constexpr uint8_t NO_POSITION = 0xFF;
+
+constexpr pile_id DECK_PILE = 0;
+constexpr pile_id FIRST_TABLEAU_PILE = 1;
+constexpr pile_id FIRST_FOUNDATION_PILE = FIRST_TABLEAU_PILE + TABLEAU_COUNT;
+constexpr uint8_t PILE_COUNT = FIRST_FOUNDATION_PILE + FOUNDATION_COUNT;
+
+/// @brief Cards left in the deck after dealing the tableaus
+constexpr uint8_t DECK_SIZE =
+    CARDS_COUNT - TABLEAU_COUNT * (TABLEAU_COUNT + 1) / 2;
+/// @brief Longest possible tableau: all face-down cards plus King to Ace
+constexpr uint8_t TABLEAU_CAPACITY = TABLEAU_COUNT - 1 + VALUE_COUNT;
+/// @brief Number of card slots reserved by every pile
+constexpr uint8_t PILE_CAPACITY =
+    DECK_SIZE > TABLEAU_CAPACITY ? DECK_SIZE : TABLEAU_CAPACITY;
@@ -0,0 +1,40 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+#include "constants.h"
+
+/// @brief SplitMix64 finalizer: a bijection where every input bit affects
+/// every output bit
+constexpr uint64_t mix64(uint64_t z) noexcept
+{
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+/// @brief Counter-based generator: every output depends only on the key and
+/// the counter, so any deal can be produced without sequential state.
+struct deal_random
+{
+  uint64_t key;
+
+  /// @return Generator of a deal. The counter steps by the same constant as
+  /// SplitMix64, so deal numbers used raw as keys would make deals that
+  /// differ by it share one stream shifted by a draw; mixing them first
+  /// spreads nearby deal numbers apart.
+  static constexpr deal_random for_deal(uint64_t deal_number) noexcept
+  {
+    return deal_random{mix64(deal_number)};
+  }
+
+  /// @return 64 random bits for the given counter value (SplitMix64)
+  constexpr uint64_t at(uint64_t counter) const noexcept
+  {
+    return mix64(key + (counter + 1) * 0x9E3779B97F4A7C15ull);
+  }
+};
+
+/// @brief Produces the dealing order of card ids for a deal number. The
+/// result is identical on every platform and standard library.
+std::array<card_id, CARDS_COUNT> make_deal(uint64_t deal_number) noexcept;
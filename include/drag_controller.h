@@ -1,32 +1,40 @@
 #pragma once
 #include <optional>
 
+#include "card_set.h"
+#include "constants.h"
 #include "raylib.h"
 
 class card;
 class pile;
 class game;
+struct board;
 struct hit_result;
 
 struct drag_overlay
 {
-  const card* root = nullptr;
+  card_id root = NO_CARD;
+  /// @brief Root and every card carried along with it
+  card_set chain;
   Vector2 mouse{0, 0};
   Vector2 offset{0, 0};
 };
 
 struct drag_controller
 {
-  card* dragged_card = nullptr;
-  pile* source_pile = nullptr;
+  card_id dragged_card = NO_CARD;
+  card_set dragged_chain;
+  pile_id source_pile = NO_PILE;
   Vector2 mouse{0, 0};
   Vector2 offset{0, 0};
 
   /// @brief Starts card dragging
+  /// @param layout Board the card belongs to
   /// @param c Dragged card
   /// @param mouse_pos Position of mouse
   /// @param card_rect Rectangle of dragged card
-  void start(card* c, Vector2 mouse_pos, Rectangle card_rect);
+  void start(const board& layout, const card* c, Vector2 mouse_pos,
+             Rectangle card_rect);
 
   void update(Vector2 mouse_pos);
   
@@ -35,11 +43,12 @@ struct drag_controller
   /// @param hit Hit test at the end of movement
   void end(game& g, const hit_result& hit);
 
-  bool is_dragging() const noexcept { return dragged_card != nullptr; }
+  bool is_dragging() const noexcept { return dragged_card != NO_CARD; }
   std::optional<drag_overlay> overlay() const noexcept
   {
     return !is_dragging() ? std::nullopt
                           : std::optional<drag_overlay>{
-                                drag_overlay{dragged_card, mouse, offset}};
+                                drag_overlay{dragged_card, dragged_chain,
+                                             mouse, offset}};
   }
 };
\ No newline at end of file
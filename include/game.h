@@ -1,49 +1,102 @@
 #pragma once
 #include <array>
+#include <chrono>
+#include <memory>
 #include <optional>
-#include <stack>
+#include <span>
+#include <vector>
 
-#include "card.h"
+#include "board.h"
+#include "game_counters.h"
+#include "game_event_queue.h"
+#include "game_status.h"
 #include "hint.h"
 #include "move.h"
+#include "move_availability.h"
+#include "move_history.h"
+#include "position_key.h"
+#include "stock_rules.h"
 
-constexpr uint8_t COLOR_COUNT = 4;
-constexpr uint8_t VALUE_COUNT = 13;
-constexpr uint8_t TABLEAU_COUNT = 7;
-constexpr uint8_t FOUNDATION_COUNT = 4;
-constexpr uint8_t CARDS_COUNT = COLOR_COUNT * VALUE_COUNT;
+class solver;
+enum class solve_result : uint8_t;
 
 struct game_state;
 struct hit_result;
 
-enum class game_status : uint8_t
-{
-  in_progress,
-  auto_solve,
-  won,
-  lost,
-};
-
 class game
 {
  public:
   game();
 
-  /// @brief Clears state and Starts a new game.
+  /// @brief Copies the game, history included. The copy publishes no events
+  /// and starts without a running hint search.
+  game(const game& other);
+  game(game&& other) noexcept;
+  game& operator=(const game& other);
+  game& operator=(game&& other) noexcept;
+  ~game();
+
+  /// @brief Clears state and Starts a new game with a random deal number.
   void new_game() noexcept;
 
-  /// @brief Advances the deck to the next card (draws a card).
+  /// @brief Clears state and Starts the given deal. The same deal number
+  /// produces the same layout on every platform.
+  void new_game(uint64_t deal_number) noexcept;
+
+  /// @return Deal number of the current game
+  uint64_t get_deal_number() const noexcept { return _deal_number; }
+
+  /// @brief Deals the next stock cards to the waste, or turns the waste over
+  /// when the stock is empty and a pass is left. The advance is recorded in
+  /// the history.
   void next_deck() noexcept;
 
+  /// @brief Changes draw count and pass limit, clamped to the deck. Takes
+  /// effect with the next deal.
+  void set_stock_rules(stock_rules rules) noexcept;
+
+  /// @return Stock rules of the next deal, see board::stock for the current
+  /// one
+  stock_rules get_stock_rules() const noexcept { return _stock_rules; }
+
+  /// @brief Makes every move_card and next_deck follow up with the foundation
+  /// moves that can never cost a win, see next_safe_move. Each one is
+  /// recorded in the history on its own.
+  void set_auto_play(bool enabled) noexcept { _auto_play = enabled; }
+  bool get_auto_play() const noexcept { return _auto_play; }
+
   /// @brief Moves a card (and its chain) to the target pile if the move is
   /// valid.
-  /// @param moved Pointer to the first card to move.
-  /// @param target Reference to the target pile.
-  void move_card(card* moved, pile& target) noexcept;
-
-  /// @brief Undoes the last move, if possible.
+  /// @param moved Id of the first card to move.
+  /// @param target Id of the target pile.
+  void move_card(card_id moved, pile_id target) noexcept;
+
+  /// @brief Plays a sequence of moves as one transaction: either every move
+  /// is legal in turn and all are applied, or none is. Stock advances are
+  /// moves without a card. Hints and status are refreshed once at the end,
+  /// then auto-play follows up as after move_card.
+  /// @return false if a move was illegal and the batch was rejected
+  bool apply_moves(std::span<const move> moves) noexcept;
+
+  /// @brief Undoes the last move or deck advance, if possible.
   void undo_move() noexcept;
 
+  /// @brief Replays the last undone move or deck advance, if possible.
+  void redo_move() noexcept;
+
+  /// @brief Jumps to the position reached after move_index entries of the
+  /// active line, undone entries included. Restores the nearest checkpoint
+  /// and replays the entries after it. Positions outside the kept history are
+  /// clamped.
+  void seek(size_t move_index) noexcept;
+
+  /// @brief Jumps to a node of the history tree, making its branch the
+  /// active line.
+  void switch_branch(history_node node) noexcept;
+
+  /// @brief Recorded moves, oldest first
+  const move_history& get_history() const noexcept { return _history; }
+
   /// @brief Exports the current game state for rendering.
   /// @return A snapshot of the current game state.
   game_state export_game_state() noexcept;
@@ -52,13 +105,53 @@ class game
   /// available
   std::optional<move> next_auto_move() noexcept;
 
-  /// @brief Trigger game to show next vali move in next game_export state
-  void show_hint() noexcept { _show_hint = true; }
+  /// @brief Trigger game to show next vali move in next game_export state.
+  /// The hint follows a winning line found by the solver; when the search
+  /// runs out of budget it falls back to the first useful move, and a deal
+  /// proven lost gets no hint.
+  void show_hint();
 
- private:
-  /// @brief Shuffles the deck of cards.
-  void shuffle_deck() noexcept;
+  /// @brief Like show_hint, but without waiting for the solver: the search
+  /// is carried out by update_analysis and the hint shows once it ends.
+  void request_hint();
+
+  /// @brief Searches for the hint requested last for about budget. A search
+  /// is dropped once the layout it started from changes.
+  /// @return true while the search goes on
+  bool update_analysis(std::chrono::microseconds budget);
+
+  /// @brief Returns an independent copy of this game, history included. The
+  /// copy publishes no events.
+  game clone() const { return game(*this); }
+
+  /// @brief Publishes every change of the game to queue, or stops publishing
+  /// if queue is nullptr. The queue must outlive its use by this game.
+  void set_event_queue(game_event_queue* queue) noexcept { _events = queue; }
+
+  /// @brief Read-only access to the current card layout.
+  const board& get_board() const noexcept { return _board; }
+
+  /// @brief Copies the current card layout. The result is trivially copyable
+  /// and may be handed to other threads.
+  board snapshot() const noexcept { return _board; }
 
+  /// @return Progress counters of the current position
+  game_counters get_counters() const noexcept;
+
+  /// @return Zobrist hash of the current position
+  uint64_t get_hash() const noexcept { return _board.hash; }
+
+  /// @return Packed encoding of the current position
+  position_key get_position_key() const noexcept
+  {
+    return make_position_key(_board);
+  }
+
+  /// @brief Replaces the current card layout and clears the move history.
+  /// @param b Layout previously obtained with snapshot().
+  void restore(const board& b) noexcept;
+
+ private:
   /// @brief Resets the board to the initial state.
   void reset_board() noexcept;
 
@@ -67,7 +160,33 @@ class game
   /// to victory
   bool has_available_moves() const noexcept;
 
-  void update_hint() noexcept;
+  /// @brief Moves to a position of the active line.
+  /// @param off_line true if the current position left the active line
+  void jump(size_t target, bool off_line) noexcept;
+
+  /// @brief Publishes an event if a queue is attached.
+  void emit(const game_event& e) noexcept;
+
+  /// @brief Publishes the events of a history entry just applied or undone.
+  void emit_move(packed_move m, bool undone) noexcept;
+
+  /// @brief Refreshes hints and status after piles from and to changed.
+  void refresh_after_move(pile_id from, pile_id to) noexcept;
+
+  /// @brief Plays safe foundation moves while the game is in progress, if
+  /// auto-play is on
+  void play_safe_moves() noexcept;
+
+  /// @brief Shows the hint of the last winning line if the layout is on it
+  /// @return false if it is not
+  bool show_known_hint() noexcept;
+
+  /// @brief Solver behind the hints, created on first use and reused
+  solver& get_solver();
+
+  /// @brief Shows the hint from a finished search of the current layout and
+  /// keeps its winning line
+  void show_solved_hint(const solver& s, solve_result result);
 
   bool check_win() const noexcept;
 
@@ -101,21 +220,40 @@ class game
 #pragma endregion
 
  private:
-  /// @brief Array of all cards in the game.
-  std::array<card, CARDS_COUNT> _cards;
+  /// @brief Cards and piles of the game.
+  board _board;
 
-  std::array<pile, TABLEAU_COUNT> _tableaus;
+  game_status _status;
 
-  std::array<pile, FOUNDATION_COUNT> _foundations;
+  /// @brief Status last published as an event
+  game_status _published_status = game_status::in_progress;
 
-  pile _deck{pile_type::deck, 0};
-  card* _current_deck = nullptr;
-  card* _picked_deck = nullptr;
+  game_event_queue* _events = nullptr;
 
-  game_status _status;
+  uint64_t _deal_number = 0;
+
+  /// @brief Stock rules applied to the next deal
+  stock_rules _stock_rules;
 
-  std::stack<move> _moves;
+  bool _auto_play = false;
+
+  move_history _history;
 
   bool _show_hint = false;
-  std::optional<hint> _valid_next_move;
+  std::optional<hint> _hint;
+
+  /// @brief Last winning line found, as the layout hash before each move and
+  /// the hint for that move. Kept while the player follows the line.
+  std::vector<uint64_t> _solution_hashes;
+  std::vector<hint> _solution_hints;
+
+  std::unique_ptr<solver> _solver;
+
+  /// @brief A search for request_hint is run a slice at a time, and the
+  /// layout hash it started from
+  bool _is_analysing = false;
+  uint64_t _analysis_hash = 0;
+
+  /// @brief Useful moves, refreshed only for the piles each move touches.
+  move_availability _availability;
 };
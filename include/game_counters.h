@@ -0,0 +1,21 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+#include "constants.h"
+
+/// @brief Progress counters of a game, read-only view for HUD and analytics
+struct game_counters
+{
+  /// @brief Cards already placed on the foundations
+  uint8_t foundation_cards = 0;
+
+  /// @brief Tableau cards still waiting to be revealed
+  uint8_t face_down_cards = 0;
+
+  /// @brief Cards left in the deck
+  uint8_t stock_size = 0;
+
+  /// @brief Highest value on the foundations per suit, 0 if none
+  std::array<uint8_t, COLOR_COUNT> foundation_rank{};
+};
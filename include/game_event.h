@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+
+#include "constants.h"
+#include "game_status.h"
+
+enum class game_event_type : uint8_t
+{
+  /// @brief The whole layout was replaced (new game, restore, seek, branch
+  /// switch). Consumers rebuild from the layout as it was at this event and
+  /// apply the following events on top of it. status holds the status before
+  /// the change.
+  layout_reset,
+  /// @brief card and the depth - 1 cards above it moved from from_pile to
+  /// to_pile
+  card_moved,
+  card_revealed,
+  card_hidden,
+  /// @brief card is the waste top now playable, NO_CARD if none; position
+  /// is the waste size and depth the number of passes made
+  stock_cursor_changed,
+  status_changed,
+};
+
+/// @brief Compact description of one change of a game
+struct game_event
+{
+  game_event_type type = game_event_type::layout_reset;
+  card_id card = NO_CARD;
+  pile_id from_pile = NO_PILE;
+  pile_id to_pile = NO_PILE;
+
+  /// @brief Position of card in to_pile after the move, or waste size
+  uint8_t position = 0;
+
+  /// @brief Number of cards moved together
+  uint8_t depth = 0;
+
+  game_status status = game_status::in_progress;
+};
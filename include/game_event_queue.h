@@ -0,0 +1,43 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+
+#include "game_event.h"
+
+/// @brief Lock-free single-producer single-consumer queue of game events in
+/// a fixed ring buffer. The game pushes from its thread and one consumer pops
+/// from any thread; neither side allocates or blocks.
+class game_event_queue
+{
+ public:
+  static constexpr size_t CAPACITY = 1024;
+
+  /// @brief Adds an event. When the queue is full the event is dropped and
+  /// the overflow flag is raised instead.
+  void push(const game_event& e) noexcept;
+
+  /// @return Oldest event, std::nullopt if the queue is empty
+  std::optional<game_event> pop() noexcept;
+
+  /// @brief Clears the overflow flag
+  /// @return true if events were dropped since the last call; the consumer
+  /// should then resynchronize from game::get_board
+  bool take_overflow() noexcept;
+
+ private:
+  std::array<game_event, CAPACITY> _events;
+
+  /// @brief Index of the next event to pop, written by the consumer
+  alignas(64) std::atomic<size_t> _head{0};
+
+  /// @brief Index of the next event to push, written by the producer
+  alignas(64) std::atomic<size_t> _tail{0};
+
+  std::atomic<bool> _overflow{false};
+};
+
+static_assert((game_event_queue::CAPACITY & (game_event_queue::CAPACITY - 1)) ==
+                  0,
+              "queue indices wrap with a mask");
@@ -1,13 +1,24 @@
 #pragma once
-#include "game.h"
+#include <cstdint>
+#include <optional>
+#include <type_traits>
 
+#include "board.h"
+#include "game_counters.h"
+#include "game_status.h"
+#include "hint.h"
+
+/// @brief Value snapshot of a game for rendering. It holds no references into
+/// the game, so it may be copied to and read on another thread.
 struct game_state
 {
-  game_status status;
-  std::array<pile, TABLEAU_COUNT>& tableaus;
-  std::array<pile, FOUNDATION_COUNT>& foundations;
-  pile& deck;
-  card* current_deck;
-  const std::stack<move>& moves;
+  game_status status = game_status::in_progress;
+  uint64_t deal_number = 0;
+  board layout;
+  uint32_t move_count = 0;
+  game_counters counters;
   std::optional<hint> next_move_hint;
-};
\ No newline at end of file
+};
+
+static_assert(std::is_trivially_copyable_v<game_state>,
+              "game_state must stay copyable with memcpy");
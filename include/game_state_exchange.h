@@ -0,0 +1,36 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include "game_state.h"
+
+/// @brief Triple buffer handing game_state snapshots from the logic thread to
+/// the render thread. The writer and the reader each own a slot and trade it
+/// for the third one, so neither side locks, waits or allocates.
+class game_state_exchange
+{
+ public:
+  /// @brief Writer side: stores state as the latest snapshot.
+  void publish(const game_state& state) noexcept;
+
+  /// @brief Reader side: returns the latest published snapshot. It stays
+  /// unchanged until the next call.
+  const game_state& latest() noexcept;
+
+ private:
+  static constexpr uint8_t INDEX_MASK = 0x3;
+  static constexpr uint8_t FRESH = 0x4;
+
+  std::array<game_state, 3> _slots;
+
+  /// @brief Slot written by publish
+  uint8_t _back = 0;
+
+  /// @brief Slot returned by latest
+  uint8_t _front = 1;
+
+  /// @brief Slot in between, with FRESH set when it holds a snapshot the
+  /// reader has not taken yet
+  std::atomic<uint8_t> _middle{2};
+};
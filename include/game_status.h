@@ -0,0 +1,10 @@
+#pragma once
+#include <cstdint>
+
+enum class game_status : uint8_t
+{
+  in_progress,
+  auto_solve,
+  won,
+  lost,
+};
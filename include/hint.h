@@ -1,8 +1,8 @@
 #pragma once
-#include "card.h"
+#include "constants.h"
 
 struct hint
 {
-  const card* movable_card = nullptr;
-  const pile* target_pile = nullptr;
-};
\ No newline at end of file
+  card_id movable_card = NO_CARD;
+  pile_id target_pile = NO_PILE;
+};
@@ -5,6 +5,6 @@ class pile;
 
 struct hit_result
 {
-  card* hit_card;
-  pile* hit_pile;
+  const card* hit_card;
+  const pile* hit_pile;
 };
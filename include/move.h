@@ -1,14 +1,70 @@
 #pragma once
-#include "card.h"
-#include "pile.h"
+#include "constants.h"
+#include "stock_rules.h"
 
 struct move
 {
-  card* moved_card = nullptr;
+  card_id moved_card = NO_CARD;
 
-  pile* from_pile = nullptr;
-  pile* to_pile = nullptr;
+  pile_id from_pile = NO_PILE;
+  pile_id to_pile = NO_PILE;
 
-  card* prev_parent = nullptr;
+  uint8_t from_position = 0;
   bool revealed_card = false;
+
+  /// @brief Stock advances are stored without a moved card
+  bool is_stock_advance() const noexcept { return moved_card == NO_CARD; }
 };
+
+/// @brief Move history entry packed into 32 bits. The moved card is not
+/// stored: it is found from the piles when the entry is undone or redone.
+class packed_move
+{
+ public:
+  constexpr packed_move() noexcept = default;
+  constexpr explicit packed_move(uint32_t bits) noexcept : _bits(bits) {}
+
+  /// @param depth Number of cards moved together
+  /// @param deck_cursor Deck cursor before the move, see board::get_deck_cursor
+  constexpr packed_move(pile_id from, pile_id to, uint8_t from_position,
+                        uint8_t depth, bool revealed,
+                        uint16_t deck_cursor) noexcept
+      : _bits(uint32_t{from} | uint32_t{to} << 4 |
+              uint32_t{from_position} << 8 | uint32_t{depth} << 13 |
+              uint32_t{revealed} << 18 | uint32_t{deck_cursor} << 19)
+  {
+  }
+
+  /// @brief Stock advances go from the deck to the deck
+  static constexpr packed_move stock_advance(uint16_t deck_cursor) noexcept
+  {
+    return packed_move(DECK_PILE, DECK_PILE, 0, 0, false, deck_cursor);
+  }
+
+  constexpr pile_id from_pile() const noexcept { return _bits & 0xF; }
+  constexpr pile_id to_pile() const noexcept { return _bits >> 4 & 0xF; }
+  constexpr uint8_t from_position() const noexcept
+  {
+    return _bits >> 8 & 0x1F;
+  }
+  constexpr uint8_t depth() const noexcept { return _bits >> 13 & 0x1F; }
+  constexpr bool revealed_card() const noexcept { return _bits >> 18 & 1; }
+  constexpr uint16_t deck_cursor() const noexcept
+  {
+    return _bits >> 19 & 0x1FF;
+  }
+
+  constexpr bool is_stock_advance() const noexcept
+  {
+    return from_pile() == DECK_PILE && to_pile() == DECK_PILE;
+  }
+
+  /// @return Raw encoding, suitable for serialization
+  constexpr uint32_t bits() const noexcept { return _bits; }
+
+ private:
+  uint32_t _bits = 0;
+};
+
+static_assert(PILE_COUNT <= 16 && PILE_CAPACITY < 32 && MAX_PASS_LIMIT < 16,
+              "packed_move fields are too narrow");
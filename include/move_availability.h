@@ -0,0 +1,49 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#include "card_set.h"
+#include "hint.h"
+
+struct board;
+
+/// @brief Per-pile cache of the moves that bring the player closer to a win:
+/// revealing tableau moves, tableau to foundation, and stock cards the draw
+/// rules let come up to anywhere. A move only invalidates the rows and
+/// columns of the piles it touches.
+class move_availability
+{
+ public:
+  /// @brief Recomputes every pile from scratch
+  void rebuild(const board& b) noexcept;
+
+  /// @brief Recomputes the piles changed by a move
+  void update(const board& b, pile_id from, pile_id to) noexcept;
+
+  /// @return true if at least one useful move exists
+  bool any() const noexcept { return _hint.has_value(); }
+
+  /// @return Suggested move, std::nullopt if no useful move exists
+  const std::optional<hint>& get_hint() const noexcept { return _hint; }
+
+ private:
+  void update_pile(const board& b, pile_id p) noexcept;
+  void update_row(pile_id source) noexcept;
+  void update_column(pile_id target) noexcept;
+  void update_hint() noexcept;
+
+  /// @brief Cards each pile accepts on top
+  std::array<card_set, PILE_COUNT> _accepts;
+
+  /// @brief Cards each pile offers to tableau targets
+  std::array<card_set, PILE_COUNT> _offers_tableau;
+
+  /// @brief Cards each pile offers to foundation targets
+  std::array<card_set, PILE_COUNT> _offers_foundation;
+
+  /// @brief Bit t of _targets[s] is set if pile s has a move to pile t
+  std::array<uint16_t, PILE_COUNT> _targets{};
+
+  std::optional<hint> _hint;
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+#include "move.h"
+
+struct board;
+
+/// @brief Upper bound of legal moves in any position: at most 4 cards fit a
+/// tableau and 4 a foundation, plus the stock advance
+constexpr uint8_t MAX_MOVES = TABLEAU_COUNT * 4 + FOUNDATION_COUNT * 4 + 1;
+
+/// @brief Fixed-capacity move buffer filled by generate_moves
+struct move_list
+{
+  std::array<move, MAX_MOVES> moves;
+  uint8_t count = 0;
+
+  void clear() noexcept { count = 0; }
+  void push(const move& m) noexcept { moves[count++] = m; }
+
+  bool empty() const noexcept { return count == 0; }
+  const move* begin() const noexcept { return moves.data(); }
+  const move* end() const noexcept { return moves.data() + count; }
+  const move& operator[](uint8_t i) const noexcept { return moves[i]; }
+};
+
+/// @brief Writes every legal move of b into out without allocating.
+/// Order: tableau to tableau (by source pile, then card id), tableau to
+/// foundation, waste to tableau and foundation, foundation to tableau, then
+/// stock advance.
+void generate_moves(const board& b, move_list& out) noexcept;
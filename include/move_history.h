@@ -0,0 +1,184 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "board.h"
+#include "move.h"
+
+/// @brief Index of a node in the history tree. Ids stay valid until the node
+/// pool fills up and the history is compacted.
+using history_node = uint16_t;
+constexpr history_node NO_NODE = 0xFFFF;
+
+/// @brief Undo history kept as a tree in a fixed node pool. Branches share
+/// their common prefix, and playing a move that was already played from the
+/// same position reuses its node. The active line runs from the root through
+/// the current position to the last branch taken; undo, redo and positions
+/// follow it. Positions are counted from the start of the game, dropped
+/// entries included.
+class move_history
+{
+ public:
+  /// @brief Number of nodes in the pool, root included
+  static constexpr size_t CAPACITY = 4096;
+
+  /// @brief Layouts are saved at every multiple of this depth
+  static constexpr size_t CHECKPOINT_INTERVAL = 64;
+
+  /// @brief Allocates the node pool and room for every checkpoint up front,
+  /// so recording never allocates
+  move_history();
+
+  /// @brief Copies the nodes in use and the checkpoints saved only
+  move_history(const move_history& other);
+  move_history(move_history&& other) noexcept = default;
+  move_history& operator=(const move_history& other);
+  move_history& operator=(move_history&& other) noexcept = default;
+
+  /// @brief Forgets every entry
+  /// @param start Layout at the root
+  void clear(const board& start) noexcept;
+
+  /// @brief Records a move played from the current position. When the pool
+  /// is full, branches off the current line are dropped first, then the
+  /// oldest entries.
+  /// @param after Layout after the move
+  void push(packed_move m, const board& after) noexcept;
+
+  /// @brief Steps back one entry
+  /// @return Entry to undo, std::nullopt if there is nothing to undo
+  std::optional<packed_move> undo() noexcept;
+
+  /// @brief Steps forward one entry along the active line
+  /// @return Entry to redo, std::nullopt if there is nothing to redo
+  std::optional<packed_move> redo() noexcept;
+
+  /// @brief Saves the layout of the current position if its depth is a
+  /// multiple of CHECKPOINT_INTERVAL
+  void save_checkpoint(const board& b) noexcept;
+
+  /// @return Highest position at or before position on the active line with
+  /// a saved layout
+  size_t nearest_checkpoint(size_t position) const noexcept;
+
+  /// @return Layout saved for a position from nearest_checkpoint
+  const board& checkpoint_layout(size_t position) const noexcept
+  {
+    return _checkpoints[(position - _first) / CHECKPOINT_INTERVAL];
+  }
+
+  /// @brief Moves the undo position without returning the skipped entries
+  /// @param position Position between first_position() and last_position()
+  void set_position(size_t position) noexcept
+  {
+    _current = _line[position - _first];
+  }
+
+  /// @brief Makes the branch through n the active line
+  /// @return Deepest position shared by the previous and the new active line
+  size_t select_branch(history_node n) noexcept;
+
+  /// @return Number of entries applied since the start of the game
+  size_t position() const noexcept { return position_of(_current); }
+
+  /// @return Oldest position that can still be reached
+  size_t first_position() const noexcept { return _first; }
+
+  /// @return Position at the end of the active line
+  size_t last_position() const noexcept { return _first + _tip; }
+
+  /// @return Number of entries that can be undone
+  size_t size() const noexcept { return _nodes[_current].depth; }
+
+  /// @return Number of entries that can be redone
+  size_t redo_size() const noexcept { return _tip - _nodes[_current].depth; }
+
+  bool empty() const noexcept { return _current == ROOT; }
+
+  /// @return i-th entry of the active line, oldest first
+  packed_move operator[](size_t i) const noexcept
+  {
+    return _nodes[_line[i + 1]].move;
+  }
+
+  /// @return Number of entries on the active line, redo entries included
+  size_t recorded() const noexcept { return _tip; }
+
+  history_node current_node() const noexcept { return _current; }
+  size_t node_count() const noexcept { return _used; }
+
+  history_node parent_of(history_node n) const noexcept
+  {
+    return _nodes[n].parent;
+  }
+  history_node first_child(history_node n) const noexcept
+  {
+    return _nodes[n].first_child;
+  }
+  history_node next_sibling(history_node n) const noexcept
+  {
+    return _nodes[n].next_sibling;
+  }
+  packed_move move_of(history_node n) const noexcept { return _nodes[n].move; }
+  size_t position_of(history_node n) const noexcept
+  {
+    return _first + _nodes[n].depth;
+  }
+
+ private:
+  struct node
+  {
+    packed_move move;
+    history_node parent = NO_NODE;
+    history_node first_child = NO_NODE;
+    history_node next_sibling = NO_NODE;
+
+    /// @brief Child on the active line, the last one entered
+    history_node redo_child = NO_NODE;
+
+    /// @brief Entries between the root and this node
+    uint16_t depth = 0;
+  };
+
+  static constexpr history_node ROOT = 0;
+  static constexpr size_t CHECKPOINT_COUNT = CAPACITY / CHECKPOINT_INTERVAL;
+
+  /// @brief Makes child of the current node current and extends the active
+  /// line through it
+  void enter(history_node child) noexcept;
+
+  /// @brief Keeps only the path from the root to the current node, dropping
+  /// its oldest part if the path alone nearly fills the pool
+  /// @return false if the whole path was dropped and after became the root
+  bool compact(const board& after) noexcept;
+
+  /// @brief Node pool of CAPACITY entries, kept on the heap so a game stays
+  /// small enough for the stack of the browser build
+  std::vector<node> _nodes;
+
+  /// @brief Nodes of the active line by depth, CAPACITY entries
+  std::vector<history_node> _line;
+
+  /// @brief Layouts by depth / CHECKPOINT_INTERVAL, growing as deeper
+  /// checkpoints are saved for the first time
+  std::vector<board> _checkpoints;
+
+  /// @brief Node each checkpoint was saved for, so layouts of other branches
+  /// are never used
+  std::array<history_node, CHECKPOINT_COUNT> _checkpoint_nodes;
+
+  size_t _used = 0;
+  history_node _current = ROOT;
+
+  /// @brief Depth of the end of the active line
+  size_t _tip = 0;
+
+  /// @brief Position of the root
+  size_t _first = 0;
+};
+
+static_assert(move_history::CAPACITY <= NO_NODE,
+              "history_node must index every node");
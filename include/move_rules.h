@@ -0,0 +1,23 @@
+#pragma once
+#include "move.h"
+
+struct board;
+
+/// @brief Checks if m can be played on b: a stock advance needs cards to deal
+/// or a pass left, any other move a face-up tableau card, a foundation top or
+/// the waste top and a valid placement.
+bool is_legal(const board& b, const move& m) noexcept;
+
+/// @brief Deals the next draw_count stock cards to the waste, or turns the
+/// waste over once the stock is empty. Only moves the waste boundary.
+void advance_deck(board& b) noexcept;
+
+/// @brief Moves a card (and its chain) whose placement was already validated.
+/// @return History entry that reverts the move
+packed_move apply_move(board& b, card_id moved, pile_id target) noexcept;
+
+/// @brief Plays a history entry again on the layout it was recorded from.
+void replay_move(board& b, packed_move m) noexcept;
+
+/// @brief Reverts a history entry on the layout right after it.
+void revert_move(board& b, packed_move m) noexcept;
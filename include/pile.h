@@ -1,6 +1,9 @@
 #pragma once
+#include <array>
 #include <cstdint>
 
+#include "constants.h"
+
 enum class pile_type : uint8_t
 {
   /// Undefined or initial state
@@ -13,44 +16,84 @@ enum class pile_type : uint8_t
   foundation,
 };
 
+constexpr pile_type type_of(pile_id id) noexcept
+{
+  if (id == DECK_PILE) return pile_type::deck;
+  if (id < FIRST_FOUNDATION_PILE) return pile_type::tableau;
+  if (id < PILE_COUNT) return pile_type::foundation;
+  return pile_type::undefined;
+}
+
 class card;
 
+/// @brief Fixed-capacity stack of card ids, bottom card first
 class pile
 {
 public:
+  constexpr pile(pile_type t = pile_type::undefined, uint8_t i = 0) noexcept
+      : type(t), index(i)
+  {
+  }
+
   pile_type type;
   uint8_t index;
-  card* first = nullptr;
 
-  bool is_empty() const { return first == nullptr; }
+  bool is_empty() const { return _height == 0; }
+
+  constexpr pile_id get_id() const noexcept
+  {
+    switch (type)
+    {
+      case pile_type::deck:
+        return DECK_PILE;
+      case pile_type::tableau:
+        return FIRST_TABLEAU_PILE + index;
+      case pile_type::foundation:
+        return FIRST_FOUNDATION_PILE + index;
+      default:
+        return NO_PILE;
+    }
+  }
 
   /// @return Number of cards assigned to this pile
-  uint8_t get_height() const noexcept;
+  uint8_t get_height() const noexcept { return _height; }
 
-  card* get_first() const noexcept { return first; }
-  card* get_last() const noexcept { return last; }
+  card_id get_first() const noexcept { return _height ? _cards[0] : NO_CARD; }
+  card_id get_last() const noexcept
+  {
+    return _height ? _cards[_height - 1] : NO_CARD;
+  }
+
+  /// @return Card at position, NO_CARD if position is out of the pile
+  card_id at(uint8_t position) const noexcept
+  {
+    return position < _height ? _cards[position] : NO_CARD;
+  }
+
+  const card_id* begin() const noexcept { return _cards.data(); }
+  const card_id* end() const noexcept { return _cards.data() + _height; }
 
   /// @brief Get the index of card in pile
   /// @param c Card to be looked for
-  /// @return Position of the passed card, -1 if card is not found
-  int8_t get_position_in_pile(const card* c) const noexcept;
+  /// @return Position of the passed card, NO_POSITION if card is not found
+  uint8_t get_position_in_pile(const card& c) const noexcept;
 
-  /// @brief erases card (and its children from this pile)
-  /// @param c
-  void erase_from_pile(card* c) noexcept;
+  /// @brief Erases count cards starting at position, shifting the rest down
+  void erase_from_pile(uint8_t position, uint8_t count) noexcept;
 
-  bool is_valid_placement(const card* c) const noexcept;
+  /// @brief Checks suit and rank of c against the top of this pile
+  bool is_valid_placement(const card& c) const noexcept;
 
-  /// @brief Tries to add card to pile's card linked list
-  /// @param c Card to be added
-  /// @return Assignment result
-  void assign_as_child(card* c) noexcept;
-  void assign_as_child(card* c, card* parent) noexcept;
+  /// @brief Inserts a run of cards at position (end of pile by default)
+  /// @param chain First card id of the run
+  /// @param count Length of the run
+  void assign_as_child(const card_id* chain, uint8_t count) noexcept;
+  void assign_as_child(const card_id* chain, uint8_t count,
+                       uint8_t position) noexcept;
 
   void reset() noexcept;
- private:
-  void update_last() noexcept;
 
- public:
-  card* last = nullptr;
-};
\ No newline at end of file
+ private:
+  std::array<card_id, PILE_CAPACITY> _cards{};
+  uint8_t _height = 0;
+};
@@ -0,0 +1,119 @@
+#pragma once
+#include <array>
+
+#include "card.h"
+#include "card_set.h"
+#include "pile.h"
+
+template <typename Rules>
+using rules_card_set = basic_card_set<Rules::cards_count>;
+
+/// @brief Checks if next may be stacked on top in a tableau of the variant
+template <typename Rules>
+constexpr bool is_tableau_follower(card top, card next) noexcept
+{
+  // aces only ever go to the foundations
+  if (next.get_value() == card_value::Ace ||
+      static_cast<uint8_t>(top.get_value()) - 1 !=
+          static_cast<uint8_t>(next.get_value()))
+  {
+    return false;
+  }
+
+  switch (Rules::build)
+  {
+    case tableau_build::alternate_color:
+      return !is_same_color(top.get_suit(), next.get_suit());
+    case tableau_build::same_suit:
+      return top.get_suit() == next.get_suit();
+    default:
+      return true;
+  }
+}
+
+/// @brief Builds, for every card, the set of cards that may be put on it
+/// @param tableau true for tableau stacking, false for foundation building
+template <typename Rules>
+constexpr std::array<rules_card_set<Rules>, Rules::cards_count> make_followers(
+    bool tableau)
+{
+  std::array<rules_card_set<Rules>, Rules::cards_count> followers{};
+
+  for (card_id top = 0; top < Rules::cards_count; top++)
+  {
+    const auto t = card::from_id(top);
+
+    for (card_id next = 0; next < Rules::cards_count; next++)
+    {
+      const auto n = card::from_id(next);
+      const bool fits =
+          tableau ? is_tableau_follower<Rules>(t, n)
+                  : t.get_suit() == n.get_suit() &&
+                        static_cast<uint8_t>(t.get_value()) + 1 ==
+                            static_cast<uint8_t>(n.get_value());
+      if (fits)
+      {
+        followers[top].insert(next);
+      }
+    }
+  }
+
+  return followers;
+}
+
+/// @brief Builds the set of cards of the given value, one per suit and deck
+template <typename Rules>
+constexpr rules_card_set<Rules> make_value_set(card_value value)
+{
+  rules_card_set<Rules> cards;
+  for (uint8_t deck = 0; deck < Rules::deck_count; deck++)
+  {
+    for (uint8_t suit = 0; suit < COLOR_COUNT; suit++)
+    {
+      cards.insert(static_cast<card_id>(
+          deck * COLOR_COUNT * VALUE_COUNT +
+          card(static_cast<card_suit>(suit), value).get_id()));
+    }
+  }
+  return cards;
+}
+
+/// @brief Cards that may be stacked on a tableau card, indexed by its id
+template <typename Rules = game_rules>
+inline constexpr auto TABLEAU_FOLLOWERS = make_followers<Rules>(true);
+
+/// @brief Cards that may follow a foundation card, indexed by its id
+template <typename Rules = game_rules>
+inline constexpr auto FOUNDATION_FOLLOWERS = make_followers<Rules>(false);
+
+template <typename Rules = game_rules>
+inline constexpr auto KINGS = make_value_set<Rules>(card_value::King);
+template <typename Rules = game_rules>
+inline constexpr auto ACES = make_value_set<Rules>(card_value::Ace);
+
+/// @brief Cards that may be put on a pile of given type with given top card
+/// @param top Top card of the pile, NO_CARD if the pile is empty
+template <typename Rules = game_rules>
+constexpr rules_card_set<Rules> valid_followers(pile_type type,
+                                                card_id top) noexcept
+{
+  switch (type)
+  {
+    case pile_type::tableau:
+      return top == NO_CARD ? KINGS<Rules> : TABLEAU_FOLLOWERS<Rules>[top];
+    case pile_type::foundation:
+      return top == NO_CARD ? ACES<Rules> : FOUNDATION_FOLLOWERS<Rules>[top];
+    default:
+      return rules_card_set<Rules>();
+  }
+}
+
+static_assert(TABLEAU_FOLLOWERS<>[card(card_suit::Spades, card_value::King)
+                                    .get_id()] ==
+              (card_set::of(card(card_suit::Hearths, card_value::Queen)
+                                .get_id()) |
+               card_set::of(card(card_suit::Diamonds, card_value::Queen)
+                                .get_id())));
+static_assert(FOUNDATION_FOLLOWERS<>[card(card_suit::Clubs, card_value::King)
+                                       .get_id()]
+                  .empty());
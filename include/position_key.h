@@ -0,0 +1,31 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+#include "constants.h"
+
+struct board;
+
+/// @brief Canonical packed encoding of a position. Two boards produce equal
+/// keys exactly when they hold the same cards in the same places.
+struct position_key
+{
+  /// Top card id of every foundation
+  static constexpr uint8_t FOUNDATION_OFFSET = 0;
+  /// Height << 3 | face-down count of every tableau
+  static constexpr uint8_t TABLEAU_OFFSET = FOUNDATION_OFFSET + FOUNDATION_COUNT;
+  /// Deck height, waste size and passes
+  static constexpr uint8_t DECK_OFFSET = TABLEAU_OFFSET + TABLEAU_COUNT;
+  /// Tableau cards bottom to top, column after column, then deck cards
+  static constexpr uint8_t CARDS_OFFSET = DECK_OFFSET + 3;
+  static constexpr uint8_t SIZE = CARDS_OFFSET + CARDS_COUNT;
+
+  std::array<uint8_t, SIZE> bytes;
+
+  bool operator==(const position_key&) const noexcept = default;
+};
+
+static_assert(TABLEAU_COUNT <= 8, "face-down counts must fit in 3 bits");
+
+/// @brief Encodes the layout of b into a position_key
+position_key make_position_key(const board& b) noexcept;
@@ -43,10 +43,14 @@ class renderer
                            const drag_overlay& drag) const noexcept;
   bool should_close() const noexcept;
 
+  /// @return Frames per second the renderer aims for
+  int get_refresh_rate() const noexcept { return _refresh_rate; }
+
   /// @brief Returns the drawing rectangle for a given card.
+  /// @param layout Board the card belongs to.
   /// @param c Pointer to the card.
   /// @return Rectangle representing the card's position and size on screen.
-  Rectangle card_rect_draw(const card* c) const noexcept;
+  Rectangle card_rect_draw(const board& layout, const card* c) const noexcept;
 
   /// @brief Registers a UI button with a label and callback.
   /// @param label Button label text.
@@ -58,7 +62,7 @@ class renderer
   void clear_buttons();
 
   /// @brief Returns the hit rectangle for a pile.
-  Rectangle pile_rect_hit(const pile& p) const noexcept;
+  Rectangle pile_rect_hit(const board& layout, const pile& p) const noexcept;
 
   void trigger_fullscreen() noexcept;
 
@@ -69,26 +73,30 @@ class renderer
                            Rectangle rect) const noexcept;
 
   /// @brief Checks if a card is hit by the mouse position.
-  bool hit_test_card(const card* c, Vector2 mouse_pos) const noexcept;
+  bool hit_test_card(const board& layout, const card* c,
+                     Vector2 mouse_pos) const noexcept;
 
   /// @brief Returns the stationary position of a card based on its pile data.
-  Vector2 stationary_card_pos(const card* c) const noexcept;
+  Vector2 stationary_card_pos(const board& layout,
+                              const card* c) const noexcept;
 
   /// @brief Returns the hit rectangle for a card.
-  Rectangle card_rect_hit(const card* c) const noexcept;
+  Rectangle card_rect_hit(const board& layout, const card* c) const noexcept;
 
   /// @brief Returns the source rectangle in the card texture atlas for a card.
-  Rectangle src_card_rect(const card* c) const noexcept;
+  Rectangle src_card_rect(const card* c, bool face_up) const noexcept;
 
   /// @brief Draws a card at its default position.
-  void draw_card(const card* c) noexcept;
+  void draw_card(const board& layout, const card* c) noexcept;
 
   /// @brief Draws a card at a specified rectangle.
   /// @param cr Rectangle to be used as screen info.
-  void draw_card(const card* c, Rectangle cr) noexcept;
+  /// @param face_up Whether the card face or back is drawn.
+  void draw_card(const card* c, Rectangle cr, bool face_up) noexcept;
 
   /// @brief Checks if a card is part of the currently dragged chain.
-  bool in_drag_chain(const card* drag_root, const card* c) const noexcept;
+  bool in_drag_chain(const std::optional<drag_overlay>& drag,
+                     card_id c) const noexcept;
 
   // UI internals
   struct ui_button
@@ -110,7 +118,7 @@ class renderer
 
   /// @brief Draws a visual hint for a suggested move.
   /// @param valid_hint Structure containing the next suggested move
-  void draw_hint(const hint valid_hint) noexcept;
+  void draw_hint(const board& layout, const hint valid_hint) noexcept;
 
   void update_scale() noexcept
   {
@@ -127,7 +135,9 @@ class renderer
   const int _screen_width = 1280;
   const int _screen_height = 768;
   const char* _window_title = "Solitaire";
-  const char* _hud_message = "Moves: %u.\n 'Z' to undo, 'R' to new game";
+  const char* _hud_message =
+      "Deal #%llu. Moves: %u. Foundations: %u/%u.\n"
+      " 'Z' to undo, 'Y' to redo, 'R' to new game";
   const int _refresh_rate = 144;
 
   Texture2D _cards_tex{};
@@ -0,0 +1,18 @@
+#pragma once
+#include <optional>
+
+#include "move.h"
+
+struct board;
+
+/// @brief Checks if moving c to a foundation can never cost a win. Aces and
+/// twos are always safe. A higher card is safe once every card that could
+/// still want it as a tableau parent can go up itself: both opposite-color
+/// cards one rank lower are on the foundations, or both opposite-color
+/// foundations are at most two ranks below c and the other suit of c's
+/// color is at most three ranks below.
+bool is_safe_foundation_card(const board& b, card_id c) noexcept;
+
+/// @return A safe move of a tableau top to a foundation, or of the waste top
+/// when the stock deals one card at a time, std::nullopt if there is none
+std::optional<move> next_safe_move(const board& b) noexcept;
@@ -0,0 +1,215 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "board.h"
+#include "hint.h"
+#include "move.h"
+
+enum class solve_result : uint8_t
+{
+  /// @brief A winning line was found
+  winnable,
+  /// @brief Every line was searched and none wins
+  unwinnable,
+  /// @brief The node or depth budget ran out first
+  unknown,
+};
+
+/// @brief Budgets of one solve
+struct solver_limits
+{
+  /// @brief Positions expanded before giving up
+  uint32_t max_nodes = 250'000;
+
+  /// @brief Steps on one line before the search stops going deeper. Each
+  /// step keeps about 2 KB; lines cut short make the result unknown.
+  uint32_t max_depth = 1024;
+
+  /// @brief Transposition table entries, rounded up to a power of two. Each
+  /// takes 8 bytes; once full, positions are searched again instead of
+  /// being remembered. The table is shared by every thread and allocated
+  /// once; each pass tags its entries instead of clearing it.
+  uint32_t table_entries = 1u << 20;
+
+  /// @brief Search threads. 1 searches on the calling thread; more split the
+  /// tree between workers that steal untried subtrees from each other.
+  uint32_t threads = 1;
+};
+
+/// @brief Exact depth-first Klondike solver. A position counts as won once
+/// the stock is empty and every tableau card is face up, since the rest can
+/// always be moved to the foundations. Deck cards are played as one step:
+/// the stock advances that bring a reachable card up, then the card itself.
+/// Positions already searched are kept in a hashed transposition table under
+/// board::canonical_hash, so column orders reached by different lines are
+/// searched once. A first pass skips moves that rarely help, a second one
+/// tries every move.
+class solver
+{
+ public:
+  explicit solver(solver_limits limits = {});
+
+  /// @brief Searches for a winning line from start
+  solve_result solve(const board& start);
+
+  /// @brief Starts a search from start that resume carries out a slice at a
+  /// time on the calling thread, whatever the thread limit
+  void begin(const board& start);
+
+  /// @brief Searches for about budget, then returns. Every call after the
+  /// result is known returns it again.
+  /// @return Result of the search begun last, std::nullopt while it goes on
+  std::optional<solve_result> resume(std::chrono::microseconds budget);
+
+  /// @brief Makes a running solve or sliced search return unknown as soon as
+  /// every thread notices. May be called from any thread.
+  void cancel() noexcept
+  {
+    _cancelled.store(true, std::memory_order_relaxed);
+    _stop.store(true, std::memory_order_relaxed);
+  }
+
+  /// @return Winning line of the last winnable solve, playable with
+  /// game::apply_moves. Stock advances are moves without a card.
+  const std::vector<move>& get_solution() const noexcept { return _line; }
+
+  /// @return Hint for each move of the solution: the card it brings up or
+  /// plays and the pile that card goes to
+  const std::vector<hint>& get_solution_hints() const noexcept
+  {
+    return _hints;
+  }
+
+  /// @return Positions expanded by the last solve
+  uint32_t get_nodes() const noexcept
+  {
+    return _nodes.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Candidate of the search: card played to pile to after the given
+  /// number of stock advances
+  struct step
+  {
+    card_id card;
+    pile_id to;
+
+    /// @brief Steps of lower rank are tried first
+    uint8_t rank;
+
+    uint8_t stock_advances;
+
+    /// @brief Deck cursor after the advances, see board::get_deck_cursor
+    uint16_t deck_cursor;
+  };
+
+  /// @brief Upper bound of steps in a position: every face-up tableau card
+  /// and every deck card fits at most two tableaus, one empty tableau and one
+  /// foundation
+  static constexpr size_t MAX_STEPS = CARDS_COUNT * 4;
+  using step_list = std::array<step, MAX_STEPS>;
+
+ private:
+  /// @brief Position on the current line and the steps left to try from it
+  struct frame
+  {
+    explicit frame(const board& b) noexcept : position(b) {}
+
+    board position;
+    step_list steps;
+    uint8_t count = 0;
+    uint8_t next = 0;
+
+    /// @brief Length of the line that reaches this position
+    uint32_t line_size = 0;
+
+    /// @brief Steps on the line that reaches this position
+    uint32_t depth = 0;
+  };
+
+  /// @brief Search state of one thread. Thieves lock it to take the last
+  /// untried step of its shallowest frame, with the line leading there.
+  struct worker
+  {
+    std::mutex lock;
+    std::vector<frame> stack;
+    std::vector<move> line;
+    std::vector<hint> hints;
+
+    /// @brief Positions expanded and not yet added to _nodes
+    uint32_t nodes = 0;
+  };
+
+  /// @brief Forgets the positions of the last pass, clears the workers and
+  /// pushes the start position on the first worker's stack
+  void begin_pass();
+
+  /// @brief Settles the result once a pass is over, beginning the second
+  /// pass after the first if needed
+  /// @return std::nullopt if the second pass was begun
+  std::optional<solve_result> end_pass();
+
+  /// @brief Searches until the tree is exhausted, the pass stops or the
+  /// deadline passes. Resumes where the last call left off.
+  void run(size_t index, std::chrono::steady_clock::time_point deadline);
+
+  /// @brief Plays step from the position of from and pushes the new position
+  /// on the worker's stack unless it is already known. The worker's line
+  /// must end at from. The caller holds the worker's lock.
+  void play(worker& w, const frame& from, const step& s);
+
+  /// @brief Takes an untried step from another worker's stack and plays it
+  /// @return false if no worker had one
+  bool steal(size_t thief);
+
+  /// @brief Moves the worker's expanded positions into _nodes and checks the
+  /// node budget
+  void flush_nodes(worker& w) noexcept;
+
+  /// @brief Remembers a position
+  /// @return false if it was already searched or is being searched
+  bool remember(uint64_t hash) noexcept;
+
+  solver_limits _limits;
+
+  std::unique_ptr<std::atomic<uint64_t>[]> _table;
+  size_t _table_mask = 0;
+
+  /// @brief Tag of the entries stored by the current pass, never 0
+  uint64_t _generation = 0;
+
+  std::vector<std::unique_ptr<worker>> _workers;
+
+  /// @brief Workers whose stack is not empty; the pass is over once none is
+  alignas(64) std::atomic<uint32_t> _busy{0};
+  alignas(64) std::atomic<uint32_t> _nodes{0};
+  uint32_t _node_budget = 0;
+
+  std::atomic<bool> _stop{false};
+  std::atomic<bool> _cancelled{false};
+  std::atomic<bool> _out_of_budget{false};
+
+  /// @brief Some line reached max_depth
+  std::atomic<bool> _cut_off{false};
+
+  /// @brief Steps of this rank and above are left out of the current pass
+  uint8_t _max_rank = 0;
+
+  board _start;
+  uint8_t _pass = 0;
+
+  /// @brief Result of the sliced search, once known
+  std::optional<solve_result> _result;
+
+  /// @brief Guards the winning line against two workers winning at once
+  std::mutex _line_lock;
+  bool _won = false;
+  std::vector<move> _line;
+  std::vector<hint> _hints;
+};
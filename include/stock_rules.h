@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+
+/// @brief Pass limit allowing any number of passes through the stock
+constexpr uint8_t UNLIMITED_PASSES = 0;
+
+/// @brief Highest pass limit that can be set
+constexpr uint8_t MAX_PASS_LIMIT = 15;
+
+/// @brief How the stock is dealt to the waste
+struct stock_rules
+{
+  /// @brief Cards dealt to the waste by one stock advance
+  uint8_t draw_count = 1;
+
+  /// @brief Passes through the stock, the first one included, or
+  /// UNLIMITED_PASSES
+  uint8_t pass_limit = UNLIMITED_PASSES;
+
+  bool operator==(const stock_rules&) const noexcept = default;
+};
+
+inline constexpr stock_rules DRAW_ONE{.draw_count = 1};
+inline constexpr stock_rules DRAW_THREE{.draw_count = 3};
@@ -0,0 +1,238 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if !defined(SOLITAIRE_NO_SIMD) && \
+    (defined(__SSE2__) || defined(_M_X64) ||    \
+     (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SOLITAIRE_TARGET_MASK_SSE2
+#include <emmintrin.h>
+#elif !defined(SOLITAIRE_NO_SIMD) && \
+    (defined(__aarch64__) || defined(_M_ARM64))
+#define SOLITAIRE_TARGET_MASK_NEON
+#include <arm_neon.h>
+#endif
+
+#include "card.h"
+
+/// @brief Set of piles, bit p for pile_id p
+using pile_mask = uint16_t;
+
+constexpr pile_mask TABLEAU_PILES = ((1u << TABLEAU_COUNT) - 1)
+                                    << FIRST_TABLEAU_PILE;
+constexpr pile_mask FOUNDATION_PILES = ((1u << FOUNDATION_COUNT) - 1)
+                                       << FIRST_FOUNDATION_PILE;
+
+static_assert(PILE_COUNT <= 16, "every pile needs a lane");
+
+/// @brief Key of one card in every lane
+struct target_keys
+{
+  alignas(16) std::array<uint8_t, 16> lanes;
+};
+
+/// @brief care of lanes comparing the whole key, and want of lanes without a
+/// target: no key reaches it
+constexpr uint8_t ANY_KEY = 0xFF;
+
+/// @brief care of lanes comparing the value only
+constexpr uint8_t VALUE_BITS = 0x0F;
+
+/// @return High nibble a tableau compares: color, suit or nothing
+constexpr uint8_t tableau_key(card_suit s) noexcept
+{
+  switch (game_rules::build)
+  {
+    case tableau_build::alternate_color:
+      return !is_same_color(s, card_suit::Spades);
+    case tableau_build::same_suit:
+      return static_cast<uint8_t>(s);
+    default:
+      return 0;
+  }
+}
+
+constexpr uint8_t make_target_key(uint8_t value, uint8_t high) noexcept
+{
+  return static_cast<uint8_t>(value | high << 4);
+}
+
+constexpr std::array<target_keys, CARDS_COUNT> make_card_keys()
+{
+  std::array<target_keys, CARDS_COUNT> keys{};
+
+  for (card_id id = 0; id < CARDS_COUNT; id++)
+  {
+    const auto c = card::from_id(id);
+    const auto value = static_cast<uint8_t>(c.get_value());
+
+    // other lanes keep key 0, which never equals ANY_KEY
+    for (pile_id p = FIRST_TABLEAU_PILE; p < FIRST_FOUNDATION_PILE; p++)
+    {
+      keys[id].lanes[p] = make_target_key(value, tableau_key(c.get_suit()));
+    }
+    for (pile_id p = FIRST_FOUNDATION_PILE; p < PILE_COUNT; p++)
+    {
+      keys[id].lanes[p] =
+          make_target_key(value, static_cast<uint8_t>(c.get_suit()));
+    }
+  }
+
+  return keys;
+}
+
+/// @brief Lane bytes a tableau or foundation wants with card c on top
+struct target_want
+{
+  uint8_t want;
+  uint8_t care;
+};
+
+constexpr target_want make_want(pile_type type, card_id top)
+{
+  if (top == NO_CARD)
+  {
+    const auto first =
+        type == pile_type::tableau ? card_value::King : card_value::Ace;
+    return {make_target_key(static_cast<uint8_t>(first), 0), VALUE_BITS};
+  }
+
+  // an Ace or a 2 on a tableau wants value 0 and a King on a foundation
+  // value 14, which no card has
+  const auto c = card::from_id(top);
+  const auto value = static_cast<uint8_t>(c.get_value());
+  if (type == pile_type::foundation)
+  {
+    return {make_target_key(value + 1, static_cast<uint8_t>(c.get_suit())),
+            ANY_KEY};
+  }
+
+  const uint8_t below = value > 2 ? value - 1 : 0;
+  switch (game_rules::build)
+  {
+    case tableau_build::alternate_color:
+      return {make_target_key(below, !tableau_key(c.get_suit())), ANY_KEY};
+    case tableau_build::same_suit:
+      return {make_target_key(below, tableau_key(c.get_suit())), ANY_KEY};
+    default:
+      return {make_target_key(below, 0), VALUE_BITS};
+  }
+}
+
+/// @brief Wanted lane bytes indexed by top card id, NO_CARD last
+constexpr std::array<target_want, CARDS_COUNT + 1> make_wants(pile_type type)
+{
+  std::array<target_want, CARDS_COUNT + 1> wants{};
+  for (card_id id = 0; id < CARDS_COUNT; id++)
+  {
+    wants[id] = make_want(type, id);
+  }
+  wants[CARDS_COUNT] = make_want(type, NO_CARD);
+  return wants;
+}
+
+inline constexpr auto CARD_KEYS = make_card_keys();
+inline constexpr auto TABLEAU_WANTS = make_wants(pile_type::tableau);
+inline constexpr auto FOUNDATION_WANTS = make_wants(pile_type::foundation);
+
+/// @brief Tops of every tableau and foundation packed one byte per pile_id,
+/// so a card is tested against all targets with a few vector instructions.
+/// A card fits pile p when its key in lane p, masked by care[p], equals
+/// want[p]. Keys hold the value in the low nibble and the suit or color the
+/// pile type compares in the high nibble.
+struct target_tops
+{
+  /// @brief Every lane empty of targets
+  constexpr target_tops() noexcept
+  {
+    want.fill(ANY_KEY);
+    care.fill(ANY_KEY);
+  }
+
+  /// @brief Sets the lane of a tableau or foundation to its top card
+  constexpr void set(pile_id p, pile_type type, card_id top) noexcept
+  {
+    const auto& wants =
+        type == pile_type::tableau ? TABLEAU_WANTS : FOUNDATION_WANTS;
+    const auto& w = wants[top == NO_CARD ? CARDS_COUNT : top];
+    want[p] = w.want;
+    care[p] = w.care;
+  }
+
+  alignas(16) std::array<uint8_t, 16> want;
+  alignas(16) std::array<uint8_t, 16> care;
+};
+
+/// @return Piles that accept c on top. Like valid_followers, it does not check
+/// that only the top card of a tableau may go to a foundation.
+inline pile_mask target_mask(const target_tops& tops, card_id c) noexcept
+{
+  const auto& keys = CARD_KEYS[c].lanes;
+
+#if defined(SOLITAIRE_TARGET_MASK_SSE2)
+  const auto key =
+      _mm_load_si128(reinterpret_cast<const __m128i*>(keys.data()));
+  const auto care =
+      _mm_load_si128(reinterpret_cast<const __m128i*>(tops.care.data()));
+  const auto want =
+      _mm_load_si128(reinterpret_cast<const __m128i*>(tops.want.data()));
+  const auto fits = _mm_cmpeq_epi8(_mm_and_si128(key, care), want);
+  return static_cast<pile_mask>(_mm_movemask_epi8(fits));
+#elif defined(SOLITAIRE_TARGET_MASK_NEON)
+  static constexpr uint8_t lane_bits[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                            1, 2, 4, 8, 16, 32, 64, 128};
+  const auto fits = vceqq_u8(vandq_u8(vld1q_u8(keys.data()),
+                                      vld1q_u8(tops.care.data())),
+                             vld1q_u8(tops.want.data()));
+  const auto bits = vandq_u8(fits, vld1q_u8(lane_bits));
+  return static_cast<pile_mask>(vaddv_u8(vget_low_u8(bits)) |
+                                vaddv_u8(vget_high_u8(bits)) << 8);
+#else
+  if constexpr (std::endian::native == std::endian::little)
+  {
+    // eight lanes per word: flag the zero bytes of (key & care) ^ want and
+    // gather their high bits into one byte
+    constexpr uint64_t LOW_BITS = 0x7F7F7F7F7F7F7F7Full;
+    constexpr uint64_t GATHER = 0x0102040810204080ull;
+
+    pile_mask mask = 0;
+    for (uint8_t half = 0; half < 2; half++)
+    {
+      uint64_t key, care, want;
+      std::memcpy(&key, keys.data() + half * 8, 8);
+      std::memcpy(&care, tops.care.data() + half * 8, 8);
+      std::memcpy(&want, tops.want.data() + half * 8, 8);
+
+      const auto diff = (key & care) ^ want;
+      const auto zero = ~(((diff & LOW_BITS) + LOW_BITS) | diff | LOW_BITS);
+      mask |= static_cast<pile_mask>(((zero >> 7) * GATHER) >> 56)
+              << half * 8;
+    }
+    return mask;
+  }
+  else
+  {
+    pile_mask mask = 0;
+    for (uint8_t p = 0; p < 16; p++)
+    {
+      if ((keys[p] & tops.care[p]) == tops.want[p])
+      {
+        mask |= 1u << p;
+      }
+    }
+    return mask;
+  }
+#endif
+}
+
+/// @brief Writes target_mask of each of count cards to out
+inline void target_masks(const target_tops& tops, const card_id* cards,
+                         uint8_t count, pile_mask* out) noexcept
+{
+  for (uint8_t i = 0; i < count; i++)
+  {
+    out[i] = target_mask(tops, cards[i]);
+  }
+}
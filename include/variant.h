@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+
+constexpr uint8_t COLOR_COUNT = 4;
+constexpr uint8_t VALUE_COUNT = 13;
+
+/// @brief How cards are stacked on a tableau: always one value lower, with
+/// the given suit restriction
+enum class tableau_build : uint8_t
+{
+  alternate_color,
+  same_suit,
+  any_suit,
+};
+
+/// @brief Compile-time rules of a solitaire variant. Tables and card sets
+/// are instantiated per variant, so no rule is looked up at run time.
+template <uint8_t Decks, uint8_t Tableaus, uint8_t Foundations,
+          tableau_build Build>
+struct variant_rules
+{
+  static constexpr uint8_t deck_count = Decks;
+  static constexpr uint8_t tableau_count = Tableaus;
+  static constexpr uint8_t foundation_count = Foundations;
+  static constexpr tableau_build build = Build;
+
+  /// @brief Card ids run deck by deck, then suit * VALUE_COUNT + value - 1
+  static constexpr uint16_t cards_count = Decks * COLOR_COUNT * VALUE_COUNT;
+
+  static_assert(cards_count < 0xFF, "card ids must fit in a byte");
+};
+
+/// @brief Only Klondike is described. Multi-deck variants are split out of
+/// the rules work: Double Klondike has 18 piles and a 59-card deck, which
+/// overflow the 16 target_mask lanes and 4-bit pile ids of packed_move, the
+/// 5-bit positions and waste size of packed_move and the deck cursor, and
+/// the 3-bit face-down counts of position_key. Static asserts next to each
+/// encoding fail if game_rules outgrows it.
+using klondike_rules = variant_rules<1, 7, 4, tableau_build::alternate_color>;
+
+/// @brief Variant the game is built for
+using game_rules = klondike_rules;
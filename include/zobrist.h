@@ -0,0 +1,64 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+#include "constants.h"
+#include "deal.h"
+#include "stock_rules.h"
+
+/// @brief Random keys for incremental position hashing. A card contributes
+/// the keys of its pile and position, plus a key while it is face up. An
+/// empty waste and no passes contribute nothing. Pile contents are hashed with
+/// the position and face keys alone.
+struct zobrist_keys
+{
+  std::array<std::array<uint64_t, CARDS_COUNT>, PILE_COUNT> pile;
+  std::array<std::array<uint64_t, CARDS_COUNT>, PILE_CAPACITY> position;
+  std::array<uint64_t, CARDS_COUNT> face_up;
+  std::array<uint64_t, PILE_CAPACITY + 1> waste_size;
+  std::array<uint64_t, MAX_PASS_LIMIT + 1> passes;
+};
+
+constexpr zobrist_keys make_zobrist_keys()
+{
+  const deal_random rng{0x50117A12E5EED500ull};
+  uint64_t counter = 0;
+  zobrist_keys keys{};
+
+  for (auto& row : keys.pile)
+    for (auto& k : row) k = rng.at(counter++);
+  for (auto& row : keys.position)
+    for (auto& k : row) k = rng.at(counter++);
+  for (auto& k : keys.face_up) k = rng.at(counter++);
+  for (auto& k : keys.waste_size) k = rng.at(counter++);
+  for (auto& k : keys.passes) k = rng.at(counter++);
+  keys.waste_size[0] = 0;
+  keys.passes[0] = 0;
+
+  return keys;
+}
+
+inline constexpr zobrist_keys ZOBRIST = make_zobrist_keys();
+
+/// @return Hash contribution of card c lying at position in pile p
+constexpr uint64_t zobrist_location(card_id c, pile_id p,
+                                    uint8_t position) noexcept
+{
+  return ZOBRIST.pile[p][c] ^ ZOBRIST.position[position][c];
+}
+
+/// @return Hash contribution of card c lying at position in whichever pile
+constexpr uint64_t zobrist_content(card_id c, uint8_t position,
+                                   bool is_face_up) noexcept
+{
+  return ZOBRIST.position[position][c] ^ (is_face_up ? ZOBRIST.face_up[c] : 0);
+}
+
+/// @brief Scrambles a hash so that sums of scrambled values stay apart
+/// (SplitMix64 finalizer)
+constexpr uint64_t zobrist_mix(uint64_t z) noexcept
+{
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
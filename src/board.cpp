@@ -0,0 +1,303 @@
+#include "board.h"
+
+#include "zobrist.h"
+
+board::board() noexcept
+{
+  for (card_id id = 0; id < CARDS_COUNT; id++)
+  {
+    cards[id] = card::from_id(id);
+  }
+
+  for (uint8_t t = 0; t < TABLEAU_COUNT; t++)
+  {
+    tableaus[t] = {pile_type::tableau, t};
+    tops.set(tableaus[t].get_id(), pile_type::tableau, NO_CARD);
+  }
+
+  for (uint8_t f = 0; f < FOUNDATION_COUNT; f++)
+  {
+    foundations[f] = {pile_type::foundation, f};
+    tops.set(foundations[f].get_id(), pile_type::foundation, NO_CARD);
+  }
+}
+
+void board::reset() noexcept
+{
+  for (auto& t : tableaus)
+  {
+    t.reset();
+    tops.set(t.get_id(), t.type, NO_CARD);
+  }
+
+  for (auto& f : foundations)
+  {
+    f.reset();
+    tops.set(f.get_id(), f.type, NO_CARD);
+  }
+
+  deck.reset();
+
+  for (auto& c : cards)
+  {
+    c.reset();
+  }
+
+  waste_size = 0;
+  passes = 0;
+  reachable_stock.clear();
+
+  face_up.clear();
+  in_foundation.clear();
+  for (auto& contents : pile_contents)
+  {
+    contents.clear();
+  }
+
+  hash = 0;
+  content_hash.fill(0);
+}
+
+pile& board::get_pile(pile_id id) noexcept
+{
+  switch (type_of(id))
+  {
+    case pile_type::tableau:
+      return tableaus[id - FIRST_TABLEAU_PILE];
+    case pile_type::foundation:
+      return foundations[id - FIRST_FOUNDATION_PILE];
+    default:
+      return deck;
+  }
+}
+
+const pile& board::get_pile(pile_id id) const noexcept
+{
+  return const_cast<board*>(this)->get_pile(id);
+}
+
+card_id board::get_parent(card_id c) const noexcept
+{
+  const auto& moved = cards[c];
+
+  if (moved.owner != NO_PILE && moved.position > 0)
+  {
+    return get_pile(moved.owner).at(moved.position - 1);
+  }
+
+  return NO_CARD;
+}
+
+card_id board::get_child(card_id c) const noexcept
+{
+  const auto& moved = cards[c];
+
+  if (moved.owner != NO_PILE)
+  {
+    return get_pile(moved.owner).at(moved.position + 1);
+  }
+
+  return NO_CARD;
+}
+
+void board::place(card_id c, pile& p) noexcept
+{
+  p.assign_as_child(&c, 1);
+  update_positions(p, p.get_height() - 1);
+
+  pile_contents[p.get_id()].insert(c);
+  if (p.type == pile_type::foundation)
+  {
+    in_foundation.insert(c);
+  }
+}
+
+void board::splice(card_id c, pile& to) noexcept
+{
+  splice(c, to, to.get_height());
+}
+
+void board::splice(card_id c, pile& to, uint8_t position) noexcept
+{
+  const auto& moved = cards[c];
+
+  if (moved.owner != NO_PILE && moved.owner != to.get_id())
+  {
+    auto& from = get_pile(moved.owner);
+    const uint8_t from_position = moved.position;
+    const uint8_t count = from.type == pile_type::deck
+                              ? 1
+                              : from.get_height() - from_position;
+
+    card_set chain;
+    for (uint8_t i = 0; i < count; i++)
+    {
+      chain.insert(from.at(from_position + i));
+    }
+
+    to.assign_as_child(from.begin() + from_position, count, position);
+    from.erase_from_pile(from_position, count);
+
+    update_positions(to, position);
+    update_positions(from, from_position);
+
+    pile_contents[from.get_id()] &= ~chain;
+    pile_contents[to.get_id()] |= chain;
+    if (from.type == pile_type::foundation)
+    {
+      in_foundation &= ~chain;
+    }
+    if (to.type == pile_type::foundation)
+    {
+      in_foundation |= chain;
+    }
+  }
+}
+
+void board::set_face_up(card_id c, bool up) noexcept
+{
+  if (face_up.contains(c) != up)
+  {
+    hash ^= ZOBRIST.face_up[c];
+    if (cards[c].owner != NO_PILE)
+    {
+      content_hash[cards[c].owner] ^= ZOBRIST.face_up[c];
+    }
+    if (up)
+    {
+      face_up.insert(c);
+    }
+    else
+    {
+      face_up.erase(c);
+    }
+  }
+}
+
+void board::set_waste_size(uint8_t size) noexcept
+{
+  if (waste_size != size)
+  {
+    if (waste_size != 0)
+    {
+      set_face_up(deck.at(waste_size - 1), false);
+    }
+
+    hash ^= ZOBRIST.waste_size[waste_size] ^ ZOBRIST.waste_size[size];
+    waste_size = size;
+
+    if (waste_size != 0)
+    {
+      set_face_up(deck.at(waste_size - 1), true);
+    }
+
+    update_reachable_stock();
+  }
+}
+
+void board::set_passes(uint8_t count) noexcept
+{
+  hash ^= ZOBRIST.passes[passes] ^ ZOBRIST.passes[count];
+  passes = count;
+  update_reachable_stock();
+}
+
+uint64_t board::compute_hash() const noexcept
+{
+  uint64_t h = 0;
+
+  for (card_id id = 0; id < CARDS_COUNT; id++)
+  {
+    const auto& c = cards[id];
+    if (c.owner != NO_PILE)
+    {
+      h ^= zobrist_location(id, c.owner, c.position);
+    }
+    if (face_up.contains(id))
+    {
+      h ^= ZOBRIST.face_up[id];
+    }
+  }
+
+  if (waste_size != 0) h ^= ZOBRIST.waste_size[waste_size];
+  if (passes != 0) h ^= ZOBRIST.passes[passes];
+
+  return h;
+}
+
+uint64_t board::canonical_hash() const noexcept
+{
+  // scrambling each column before adding them up keeps columns apart while
+  // their order drops out; the foundations hold whatever the other piles do
+  // not, in the only order their suits allow
+  uint64_t h = zobrist_mix(content_hash[DECK_PILE]);
+  for (const auto& t : tableaus)
+  {
+    h += zobrist_mix(content_hash[t.get_id()]);
+  }
+
+  return h ^ ZOBRIST.waste_size[waste_size] ^ ZOBRIST.passes[passes];
+}
+
+void board::update_positions(const pile& p, uint8_t position) noexcept
+{
+  const auto id = p.get_id();
+
+  for (uint8_t i = position; i < p.get_height(); i++)
+  {
+    const auto c_id = p.at(i);
+    auto& c = cards[c_id];
+    const bool is_face_up = face_up.contains(c_id);
+
+    if (c.owner != NO_PILE)
+    {
+      hash ^= zobrist_location(c_id, c.owner, c.position);
+      content_hash[c.owner] ^= zobrist_content(c_id, c.position, is_face_up);
+    }
+    c.owner = id;
+    c.position = i;
+    hash ^= zobrist_location(c_id, id, i);
+    content_hash[id] ^= zobrist_content(c_id, i, is_face_up);
+  }
+
+  if (p.type != pile_type::deck)
+  {
+    tops.set(id, p.type, p.get_last());
+  }
+  else
+  {
+    update_reachable_stock();
+  }
+}
+
+void board::update_reachable_stock() noexcept
+{
+  const uint8_t height = deck.get_height();
+  const uint8_t draw = stock.draw_count;
+  reachable_stock.clear();
+
+  // without taking cards the waste grows by draw cards per advance, so its
+  // tops are every draw-th card from the cursor on, and the last card
+  if (waste_top() != NO_CARD)
+  {
+    reachable_stock.insert(waste_top());
+  }
+  for (int top = waste_size + draw - 1; top < height; top += draw)
+  {
+    reachable_stock.insert(deck.at(top));
+  }
+  if (waste_size < height)
+  {
+    reachable_stock.insert(deck.get_last());
+  }
+
+  // every later pass starts from an empty waste and deals the same tops
+  if (!deck.is_empty() && has_pass_left())
+  {
+    for (int top = draw - 1; top < height; top += draw)
+    {
+      reachable_stock.insert(deck.at(top));
+    }
+    reachable_stock.insert(deck.get_last());
+  }
+}
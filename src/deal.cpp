@@ -0,0 +1,41 @@
+#include "deal.h"
+
+/// @brief Unbiased value in [0, bound) using multiply-shift with rejection
+static uint32_t bounded(const deal_random& rng, uint64_t& counter,
+                        uint32_t bound) noexcept
+{
+  const uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+
+  while (true)
+  {
+    const auto r = static_cast<uint32_t>(rng.at(counter++) >> 32);
+    const uint64_t m = static_cast<uint64_t>(r) * bound;
+    if (static_cast<uint32_t>(m) >= threshold)
+    {
+      return static_cast<uint32_t>(m >> 32);
+    }
+  }
+}
+
+std::array<card_id, CARDS_COUNT> make_deal(uint64_t deal_number) noexcept
+{
+  std::array<card_id, CARDS_COUNT> order;
+  for (card_id id = 0; id < CARDS_COUNT; id++)
+  {
+    order[id] = id;
+  }
+
+  const auto rng = deal_random::for_deal(deal_number);
+  uint64_t counter = 0;
+
+  // Fisher-Yates
+  for (uint8_t i = CARDS_COUNT - 1; i > 0; i--)
+  {
+    const auto j = bounded(rng, counter, i + 1);
+    const auto tmp = order[i];
+    order[i] = order[j];
+    order[j] = tmp;
+  }
+
+  return order;
+}
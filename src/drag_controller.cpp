@@ -1,16 +1,28 @@
 #include "drag_controller.h"
 
+#include "board.h"
 #include "card.h"
 #include "game.h"
 #include "hit_result.h"
 #include "pile.h"
 
-void drag_controller::start(card* c, Vector2 mouse_pos, Rectangle card_rect)
+void drag_controller::start(const board& layout, const card* c,
+                            Vector2 mouse_pos, Rectangle card_rect)
 {
-  if (c && c->face_up)
+  if (c && layout.face_up.contains(c->get_id()))
   {
-    dragged_card = c;
+    dragged_card = c->get_id();
     source_pile = c->owner;
+
+    dragged_chain = card_set::of(c->get_id());
+    if (type_of(c->owner) != pile_type::deck)
+    {
+      for (auto it = layout.get_child(c->get_id()); it != NO_CARD;
+           it = layout.get_child(it))
+      {
+        dragged_chain.insert(it);
+      }
+    }
     mouse = mouse_pos;
     offset = Vector2{mouse_pos.x - card_rect.x, mouse_pos.y - card_rect.y};
   }
@@ -18,7 +30,7 @@ void drag_controller::start(card* c, Vector2 mouse_pos, Rectangle card_rect)
 
 void drag_controller::update(Vector2 mouse_pos)
 {
-  if (dragged_card)
+  if (is_dragging())
   {
     mouse = mouse_pos;
   }
@@ -26,20 +38,25 @@ void drag_controller::update(Vector2 mouse_pos)
 
 void drag_controller::end(game& g, const hit_result& hit)
 {
-  if (dragged_card)
+  if (is_dragging())
   {
-    pile* target = hit.hit_pile;
-    if (!target && hit.hit_card)
+    pile_id target = NO_PILE;
+    if (hit.hit_pile)
+    {
+      target = hit.hit_pile->get_id();
+    }
+    else if (hit.hit_card)
     {
       target = hit.hit_card->owner;
     }
-    if (target)
+    if (target != NO_PILE)
     {
-      g.move_card(dragged_card, *target);
+      g.move_card(dragged_card, target);
     }
 
-    dragged_card = nullptr;
-    source_pile = nullptr;
+    dragged_card = NO_CARD;
+    dragged_chain.clear();
+    source_pile = NO_PILE;
     mouse = Vector2{0, 0};
     offset = Vector2{0, 0};
   }
@@ -1,631 +1,539 @@
 #include "game.h"
 
 #include <algorithm>
-#include <format>
-#include <iostream>
+#include <bit>
 #include <random>
 
-#include "console_card.h"
+#include "deal.h"
 #include "game_state.h"
 #include "hit_result.h"
-
-game::game()
+#include "move_rules.h"
+#include "safe_moves.h"
+#include "solver.h"
+
+/// @brief Limits of the hint solver. Its table is allocated once per game,
+/// and a smaller one keeps that cheap enough for a frame.
+constexpr solver_limits HINT_LIMITS{.table_entries = 1u << 18};
+
+game::game() { new_game(); }
+
+game::game(const game& other)
+    : _board(other._board),
+      _status(other._status),
+      _published_status(other._published_status),
+      _deal_number(other._deal_number),
+      _stock_rules(other._stock_rules),
+      _auto_play(other._auto_play),
+      _history(other._history),
+      _show_hint(other._show_hint),
+      _hint(other._hint),
+      _solution_hashes(other._solution_hashes),
+      _solution_hints(other._solution_hints),
+      _availability(other._availability)
 {
-  // Initialize all cards in the array
-  for (uint8_t suite = 0; suite < COLOR_COUNT; suite++)
-  {
-    for (uint8_t value = 1; value <= VALUE_COUNT; value++)
-    {
-      _cards[suite * VALUE_COUNT + (value - 1)] =
-          card(static_cast<card_suit>(suite), static_cast<card_value>(value));
-    }
-  }
+}
 
-  for (uint8_t t = 0; t < TABLEAU_COUNT; t++)
-  {
-    _tableaus[t] = {pile_type::tableau, t};
-  }
+game::game(game&& other) noexcept = default;
 
-  for (uint8_t f = 0; f < FOUNDATION_COUNT; f++)
-  {
-    _foundations[f] = {pile_type::foundation, f};
-  }
+game& game::operator=(const game& other) { return *this = game(other); }
 
-  new_game();
-}
+game& game::operator=(game&& other) noexcept = default;
+
+game::~game() = default;
 
-void game::shuffle_deck() noexcept
+void game::new_game() noexcept
 {
   std::random_device rd;
-  std::mt19937 g(rd());
-  std::shuffle(_cards.begin(), _cards.end(), g);
+  new_game(static_cast<uint64_t>(rd()) << 32 | rd());
 }
 
-void game::new_game() noexcept
+void game::new_game(uint64_t deal_number) noexcept
 {
   reset_board();
+  _board.stock = _stock_rules;
 
-  shuffle_deck();
-
-  while (!_moves.empty())
-  {
-    _moves.pop();
-  }
+  _deal_number = deal_number;
+  const auto order = make_deal(deal_number);
 
   uint8_t usedCardIndex = 0;
   for (uint8_t tableauIndex = 0; tableauIndex < TABLEAU_COUNT; tableauIndex++)
   {
-    auto& tableau = _tableaus[tableauIndex];
+    auto& tableau = _board.tableaus[tableauIndex];
 
     for (uint8_t tableuCards = 0; tableuCards <= tableauIndex; tableuCards++)
     {
-      tableau.assign_as_child(&_cards[usedCardIndex++]);
+      _board.place(order[usedCardIndex++], tableau);
     }
 
-    tableau.get_last()->face_up = true;
+    _board.set_face_up(tableau.get_last(), true);
   }
 
-  auto deck_last = _deck.get_last();
   while (usedCardIndex < CARDS_COUNT)
   {
-    _deck.assign_as_child(&_cards[usedCardIndex++]);
+    _board.place(order[usedCardIndex++], _board.deck);
   }
 
-  _current_deck = nullptr;
-  _picked_deck = nullptr;
-
   _status = game_status::in_progress;
+  _history.clear(_board);
 
   _show_hint = false;
-  update_hint();
+  _solution_hashes.clear();
+  _solution_hints.clear();
+  _is_analysing = false;
+  _availability.rebuild(_board);
+  emit(game_event{.type = game_event_type::layout_reset,
+                  .status = _published_status});
+
+  // a deal may offer no useful move at all
+  update_status();
 }
 
 void game::next_deck() noexcept
 {
-  if (!_deck.is_empty())
+  if (_board.can_advance_stock())
   {
-    if (_picked_deck)
-    {
-      _current_deck = _picked_deck;
-      _picked_deck = nullptr;
-    }
-    else
-    {
-      if (_current_deck)
-      {
-        _current_deck->face_up = false;
-        _current_deck = _current_deck->next;
-      }
-      else
-      {
-        _current_deck = _deck.get_first();
-      }
-    }
-
-    if (_current_deck)
-    {
-      _current_deck->face_up = true;
-    }
+    const auto record_move =
+        packed_move::stock_advance(_board.get_deck_cursor());
+    advance_deck(_board);
+    _history.push(record_move, _board);
+    emit_move(record_move, false);
+    refresh_after_move(DECK_PILE, DECK_PILE);
+    play_safe_moves();
   }
 }
 
-void game::move_card(card* moved, pile& target) noexcept
+void game::set_stock_rules(stock_rules rules) noexcept
 {
-  if (moved && moved->owner)
-  {
-    if (target.is_valid_placement(moved))
-    {
-      move newMove{moved, moved->owner, &target};
-      bool is_from_deck = moved->owner->type == pile_type::deck;
-      auto moved_parent = moved->get_parent();
-
-      newMove.prev_parent = moved_parent;
-      if (is_from_deck)
-      {
-        _picked_deck = moved->next;
-        _current_deck = nullptr;
-      }
-      else if (moved_parent && !moved_parent->face_up)
-      {
-        moved_parent->face_up = true;
-        newMove.revealed_card = true;
-      }
-
-      moved->owner->erase_from_pile(moved);
-      target.assign_as_child(moved);
-
-      _moves.push(newMove);
-
-      _show_hint = false;
-      if (_valid_next_move && _valid_next_move->movable_card == moved)
-      {
-        _valid_next_move = std::nullopt;
-      }
-      update_status();
-    }
-  }
+  _stock_rules = stock_rules{
+      .draw_count = std::clamp<uint8_t>(rules.draw_count, 1, DECK_SIZE),
+      .pass_limit = std::min(rules.pass_limit, MAX_PASS_LIMIT),
+  };
 }
 
-void game::undo_move() noexcept
+void game::move_card(card_id moved, pile_id target_id) noexcept
 {
-  if (!_moves.empty())
+  if (is_legal(_board, move{.moved_card = moved, .to_pile = target_id}))
   {
-    auto& last_move = _moves.top();
-    _moves.pop();
-
-    auto moved_card = last_move.moved_card;
-    auto from_pile = last_move.from_pile;
-    auto to_pile = last_move.to_pile;
-    auto prev_parent = last_move.prev_parent;
-    const auto is_from_deck = from_pile->type == pile_type::deck;
-
-    moved_card->face_up = !is_from_deck;
-    to_pile->erase_from_pile(moved_card);
-    if (is_from_deck)
-    {
-      from_pile->assign_as_child(moved_card, prev_parent);
-    }
-    else if (prev_parent)
-    {
-      from_pile->assign_as_child(moved_card, prev_parent);
-
-      if (last_move.revealed_card)
-      {
-        prev_parent->face_up = false;
-      }
-    }
-    else
-    {
-      from_pile->assign_as_child(moved_card);
-    }
-
-    if (_picked_deck && _picked_deck == moved_card->next)
-    {
-      if (_current_deck)
-      {
-        _current_deck->face_up = false;
-      }
-      _current_deck = moved_card;
-      _current_deck->face_up = true;
-      _picked_deck = nullptr;
-    }
-
-    _show_hint = false;
-    _valid_next_move = std::nullopt;
-    update_status();
+    const auto record_move = apply_move(_board, moved, target_id);
+    _history.push(record_move, _board);
+    emit_move(record_move, false);
+    refresh_after_move(record_move.from_pile(), target_id);
+    play_safe_moves();
   }
 }
 
-game_state game::export_game_state() noexcept
-{
-  return game_state{
-      .status = _status,
-      .tableaus = _tableaus,
-      .foundations = _foundations,
-      .deck = _deck,
-      .current_deck = _current_deck,
-      .moves = _moves,
-      .next_move_hint = _show_hint ? _valid_next_move : std::nullopt,
-  };
-}
-
-std::optional<move> game::next_auto_move() noexcept
+/// @brief Plays a move already checked with is_legal, or a stock advance
+/// @return History entry of the move
+static packed_move play(board& b, const move& m) noexcept
 {
-  for (auto& t : _tableaus)
+  if (m.is_stock_advance())
   {
-    auto t_card = t.get_last();
-
-    if (t_card)
-    {
-      for (auto& f : _foundations)
-      {
-        if (f.is_valid_placement(t_card))
-        {
-          return std::optional<move>(move{
-              .moved_card = t_card,
-              .to_pile = &f,
-          });
-        }
-      }
-    }
+    const auto record_move = packed_move::stock_advance(b.get_deck_cursor());
+    advance_deck(b);
+    return record_move;
   }
-  return std::nullopt;
+  return apply_move(b, m.moved_card, m.to_pile);
 }
 
-void game::reset_board() noexcept
+bool game::apply_moves(std::span<const move> moves) noexcept
 {
-  for (auto& tPile : _tableaus)
+  // check the whole batch on a copy first, so a rejected batch leaves the
+  // game untouched
+  board scratch = _board;
+  for (const auto& m : moves)
   {
-    tPile.reset();
+    if (!is_legal(scratch, m))
+    {
+      return false;
+    }
+    play(scratch, m);
   }
 
-  for (auto& fPile : _foundations)
+  for (const auto& m : moves)
   {
-    fPile.reset();
+    const auto record_move = play(_board, m);
+    _history.push(record_move, _board);
+    emit_move(record_move, false);
   }
 
-  _deck.reset();
+  _show_hint = false;
+  _availability.rebuild(_board);
+  update_status();
+  play_safe_moves();
+  return true;
+}
 
-  for (auto& card : _cards)
+void game::undo_move() noexcept
+{
+  const auto last_move = _history.undo();
+  if (!last_move)
   {
-    card.reset();
+    return;
   }
+
+  revert_move(_board, *last_move);
+  emit_move(*last_move, true);
+  refresh_after_move(last_move->from_pile(), last_move->to_pile());
 }
 
-bool game::has_auto_completion_finished() const noexcept
+void game::redo_move() noexcept
 {
-  for (const auto& c : _cards)
+  const auto next_move = _history.redo();
+  if (!next_move)
   {
-    if (!c.owner || c.owner->type != pile_type::foundation)
-    {
-      return false;
-    }
+    return;
   }
-  return true;
+
+  replay_move(_board, *next_move);
+  _history.save_checkpoint(_board);
+  emit_move(*next_move, false);
+  refresh_after_move(next_move->from_pile(), next_move->to_pile());
 }
 
-bool game::has_available_moves() const noexcept
+void game::seek(size_t move_index) noexcept
 {
-  return _valid_next_move.has_value();
+  jump(std::clamp(move_index, _history.first_position(),
+                  _history.last_position()),
+       false);
 }
 
-void game::update_hint() noexcept
+void game::switch_branch(history_node node) noexcept
 {
-  // check cached valid move
-  if (_valid_next_move.has_value())
+  if (node < _history.node_count())
   {
-    auto [cached_card, cached_pile] = _valid_next_move.value();
-
-    if (cached_card && cached_pile && cached_card->owner &&
-        cached_card->owner->type != pile_type::foundation)
-    {
-      if (cached_pile->is_valid_placement(cached_card))
-      {
-        return;
-      }
-    }
+    const auto shared = _history.select_branch(node);
+    jump(_history.position_of(node), _history.position() > shared);
   }
+}
 
-  // tableau to tableau
-  for (const auto& t_from : _tableaus)
-  {
-    card* from_card = t_from.get_first();
-    card* from_parent = nullptr;
-    while (from_card && !from_card->face_up)
-    {
-      from_parent = from_card;
-      from_card = from_card->next;
-    }
+void game::jump(size_t target, bool off_line) noexcept
+{
+  const auto checkpoint = _history.nearest_checkpoint(target);
+  const auto position = _history.position();
 
-    if (from_parent && from_card)
-    {
-      for (const auto& t_to : _tableaus)
-      {
-        if (&t_from == &t_to)
-        {
-          continue;
-        }
-        if (t_to.is_valid_placement(from_card))
-        {
-          _valid_next_move =
-              hint{.movable_card = from_card, .target_pile = &t_to};
-          return;
-        }
-      }
-    }
+  // replaying forward from here may be shorter than from the checkpoint
+  if (off_line || position > target || position < checkpoint)
+  {
+    _board = _history.checkpoint_layout(checkpoint);
+    _history.set_position(checkpoint);
   }
 
-  // tableau to foundation
-  for (const auto& t : _tableaus)
+  while (_history.position() < target)
   {
-    const auto t_last = t.get_last();
-    if (t_last)
-    {
-      for (auto& f : _foundations)
-      {
-        if (f.is_valid_placement(t_last))
-        {
-          _valid_next_move = hint{.movable_card = t_last, .target_pile = &f};
-          return;
-        }
-      }
-    }
+    replay_move(_board, *_history.redo());
+    _history.save_checkpoint(_board);
   }
 
-  // deck to foundation or tableau
-  for (auto d_card = _deck.first; d_card; d_card = d_card->next)
+  _status = game_status::in_progress;
+  _show_hint = false;
+  _availability.rebuild(_board);
+  emit(game_event{.type = game_event_type::layout_reset,
+                  .status = _published_status});
+  update_status();
+}
+
+void game::emit(const game_event& e) noexcept
+{
+  if (_events)
   {
-    for (const auto& t : _tableaus)
-    {
-      if (t.is_valid_placement(d_card))
-      {
-        _valid_next_move = hint{.movable_card = d_card, .target_pile = &t};
-        return;
-      }
-    }
-    for (const auto& f : _foundations)
-    {
-      if (f.is_valid_placement(d_card))
-      {
-        _valid_next_move = hint{.movable_card = d_card, .target_pile = &f};
-        return;
-      }
-    }
+    _events->push(e);
   }
-
-  _valid_next_move = std::nullopt;
 }
 
-bool game::check_win() const noexcept
+void game::emit_move(packed_move m, bool undone) noexcept
 {
-  if (!_deck.is_empty())
+  if (!_events)
   {
-    return false;
+    return;
   }
-  for (auto& card : _cards)
+
+  if (!m.is_stock_advance())
   {
-    if (!card.face_up)
+    const auto& from = _board.get_pile(m.from_pile());
+    const auto& to = _board.get_pile(m.to_pile());
+    const auto moved = undone ? from.at(m.from_position())
+                              : to.at(to.get_height() - m.depth());
+
+    emit(game_event{
+        .type = game_event_type::card_moved,
+        .card = moved,
+        .from_pile = undone ? m.to_pile() : m.from_pile(),
+        .to_pile = undone ? m.from_pile() : m.to_pile(),
+        .position = _board.cards[moved].position,
+        .depth = m.depth(),
+    });
+
+    if (m.revealed_card())
     {
-      return false;
+      emit(game_event{
+          .type = undone ? game_event_type::card_hidden
+                         : game_event_type::card_revealed,
+          .card = from.at(m.from_position() - 1),
+          .from_pile = m.from_pile(),
+      });
     }
   }
-  return true;
-}
 
-void game::update_status() noexcept
-{
-  if (_status == game_status::auto_solve)
+  if (m.from_pile() == DECK_PILE)
   {
-    if (has_auto_completion_finished())
-    {
-      _status = game_status::won;
-    }
+    emit(game_event{.type = game_event_type::stock_cursor_changed,
+                    .card = _board.waste_top(),
+                    .position = _board.waste_size,
+                    .depth = _board.passes});
   }
-  else
+}
+
+void game::refresh_after_move(pile_id from, pile_id to) noexcept
+{
+  _show_hint = false;
+  _availability.update(_board, from, to);
+  update_status();
+}
+
+void game::play_safe_moves() noexcept
+{
+  while (_auto_play && _status == game_status::in_progress)
   {
-    if (check_win())
+    const auto safe = next_safe_move(_board);
+    if (!safe)
     {
-      _status = game_status::auto_solve;
-    }
-    else
-    {
-      update_hint();
-      if (!has_available_moves())
-      {
-        _status = game_status::lost;
-      }
-      else
-      {
-        _status = game_status::in_progress;
-      }
+      return;
     }
+
+    const auto record_move =
+        apply_move(_board, safe->moved_card, safe->to_pile);
+    _history.push(record_move, _board);
+    emit_move(record_move, false);
+    refresh_after_move(safe->from_pile, safe->to_pile);
   }
 }
 
-#pragma region Debug
+void game::restore(const board& b) noexcept
+{
+  _board = b;
+
+  _history.clear(_board);
+
+  _status = game_status::in_progress;
+  _show_hint = false;
+  _solution_hashes.clear();
+  _solution_hints.clear();
+  _is_analysing = false;
+  _availability.rebuild(_board);
+  emit(game_event{.type = game_event_type::layout_reset,
+                  .status = _published_status});
+  update_status();
+}
 
-void game::print_cards() const
+void game::show_hint()
 {
-  std::cout << "-----Cards------" << std::endl;
-  for (const auto& card : _cards)
+  _is_analysing = false;
+  if (show_known_hint())
   {
-    print_card(card);
+    return;
   }
+
+  auto& s = get_solver();
+  show_solved_hint(s, s.solve(_board));
 }
 
-void game::print_board() const
+void game::request_hint()
 {
-  std::cout << "-----Tableau------" << std::endl;
-  for (int tIndex = 0; tIndex < TABLEAU_COUNT; tIndex++)
+  if (show_known_hint() || (_is_analysing && _analysis_hash == _board.hash))
   {
-    const auto& tableau = _tableaus[tIndex];
-    std::cout << std::format("Tableau{} has: {} cards. Top: ", tIndex,
-                             tableau.get_height());
-
-    if (!tableau.is_empty())
-    {
-      print_card(*tableau.get_last());
-    }
-    else
-    {
-      std::cout << "---" << std::endl;
-    }
+    return;
   }
 
-  std::cout << "-----Foundation------" << std::endl;
-  for (int fIndex = 0; fIndex < FOUNDATION_COUNT; fIndex++)
-  {
-    const auto& foundation = _foundations.at(fIndex);
-    std::cout << std::format("Foundation{} has: {} cards. Top: ", fIndex,
-                             foundation.get_height());
+  get_solver().begin(_board);
+  _is_analysing = true;
+  _analysis_hash = _board.hash;
+}
 
-    if (!foundation.is_empty())
-    {
-      print_card(*foundation.get_last());
-    }
-    else
-    {
-      std::cout << "---" << std::endl;
-    }
+bool game::update_analysis(std::chrono::microseconds budget)
+{
+  if (!_is_analysing)
+  {
+    return false;
   }
-
-  std::cout << "-----Deck------" << std::endl;
-  std::cout << std::format(
-      "Deck has: {} cards. Index {}. Current card: ", _deck.get_height(),
-      _deck.get_position_in_pile(_current_deck));
-  if (_current_deck)
+  if (_analysis_hash != _board.hash)
   {
-    print_card(*_current_deck);
+    _is_analysing = false;
+    return false;
   }
-  else
+
+  const auto result = _solver->resume(budget);
+  if (!result)
   {
-    std::cout << "---" << std::endl;
+    return true;
   }
 
-  std::cout << "----Moves----" << std::endl;
-  std::cout << std::format("MovesCount: {}", _moves.size()) << std::endl;
+  _is_analysing = false;
+  show_solved_hint(*_solver, *result);
+  return false;
 }
 
-void game::move_deck_to_tableau()
+bool game::show_known_hint() noexcept
 {
-  if (_current_deck)
+  const auto known = std::find(_solution_hashes.begin(),
+                               _solution_hashes.end(), _board.hash);
+  if (known == _solution_hashes.end())
   {
-    int targetIndex = -1;
+    return false;
+  }
 
-    for (uint8_t t = 0; t < TABLEAU_COUNT; t++)
-    {
-      auto& tableau = _tableaus[t];
-      if (tableau.is_empty())
-      {
-        if (_current_deck->get_value() == card_value::King)
-        {
-          targetIndex = t;
-          break;
-        }
-      }
-      else
-      {
-        auto top = tableau.get_last();
-        if (top->is_valid_placement(*_current_deck))
-        {
-          targetIndex = t;
-          break;
-        }
-      }
-    }
+  _show_hint = true;
+  _hint = _solution_hints[known - _solution_hashes.begin()];
+  return true;
+}
 
-    if (targetIndex >= 0)
-    {
-      move_card(_current_deck, _tableaus[targetIndex]);
-    }
+solver& game::get_solver()
+{
+  if (!_solver)
+  {
+    _solver = std::make_unique<solver>(HINT_LIMITS);
   }
+  return *_solver;
 }
 
-void game::move_deck_to_foundation()
+void game::show_solved_hint(const solver& s, solve_result result)
 {
-  if (_current_deck)
+  _show_hint = true;
+  _solution_hashes.clear();
+  _solution_hints.clear();
+
+  if (result == solve_result::unwinnable)
   {
-    int foundationIndex = -1;
+    _hint = std::nullopt;
+    return;
+  }
+  if (result == solve_result::unknown || s.get_solution().empty())
+  {
+    _hint = _availability.get_hint();
+    return;
+  }
 
-    for (uint8_t i = 0; i < FOUNDATION_COUNT; i++)
+  board scratch = _board;
+  for (const auto& m : s.get_solution())
+  {
+    _solution_hashes.push_back(scratch.hash);
+    if (m.is_stock_advance())
     {
-      auto& foundation = _foundations[i];
-      if (foundation.is_empty())
-      {
-        if (_current_deck->get_value() == card_value::Ace)
-        {
-          foundationIndex = i;
-          break;
-        }
-      }
-      else
-      {
-        auto top = foundation.get_last();
-        if (top->is_valid_placement(*_current_deck))
-        {
-          foundationIndex = i;
-          break;
-        }
-      }
+      advance_deck(scratch);
     }
-
-    if (foundationIndex >= 0)
+    else
     {
-      move_card(_current_deck, _foundations[foundationIndex]);
+      apply_move(scratch, m.moved_card, m.to_pile);
     }
   }
+  _solution_hints = s.get_solution_hints();
+  _hint = _solution_hints.front();
 }
 
-void game::move_tableau_to_foundation()
+game_state game::export_game_state() noexcept
 {
-  uint8_t foundationIndex = 0;
-  uint8_t tableauIndex = 0;
-  bool found = false;
+  return game_state{
+      .status = _status,
+      .deal_number = _deal_number,
+      .layout = _board,
+      .move_count = static_cast<uint32_t>(_history.size()),
+      .counters = get_counters(),
+      .next_move_hint = _show_hint ? _hint : std::nullopt,
+  };
+}
 
-  for (uint8_t t = 0; t < TABLEAU_COUNT && !found; t++)
+std::optional<move> game::next_auto_move() noexcept
+{
+  for (const auto& t : _board.tableaus)
   {
-    const auto tableauCard = _tableaus[t].get_last();
+    auto t_card = t.get_last();
 
-    if (tableauCard)
+    if (t_card != NO_CARD)
     {
-      for (uint8_t f = 0; f < FOUNDATION_COUNT && !found; f++)
+      const pile_mask targets =
+          target_mask(_board.tops, t_card) & FOUNDATION_PILES;
+      if (targets)
       {
-        const auto foundationCard = _foundations[f].get_last();
-        if ((tableauCard->get_value() == card_value::Ace && !foundationCard) ||
-            (foundationCard &&
-             foundationCard->is_valid_placement(*tableauCard)))
-        {
-          foundationIndex = f;
-          tableauIndex = t;
-          found = true;
-        }
+        return std::optional<move>(move{
+            .moved_card = t_card,
+            .from_pile = t.get_id(),
+            .to_pile = static_cast<pile_id>(std::countr_zero(targets)),
+        });
       }
     }
   }
+  return std::nullopt;
+}
+
+void game::reset_board() noexcept { _board.reset(); }
 
-  if (found)
+game_counters game::get_counters() const noexcept
+{
+  game_counters counters{
+      .foundation_cards = _board.in_foundation.size(),
+      .face_down_cards = (~(_board.face_up | _board.in_foundation |
+                             _board.pile_contents[DECK_PILE]))
+                             .size(),
+      .stock_size = _board.deck.get_height(),
+  };
+
+  // foundations are built from the Ace up, so a suit's count is its rank
+  for (uint8_t color = 0; color < COLOR_COUNT; color++)
   {
-    move_card(_tableaus[tableauIndex].get_last(),
-              _foundations[foundationIndex]);
+    counters.foundation_rank[color] =
+        (_board.in_foundation & card_set::suit(color)).size();
   }
+
+  return counters;
 }
 
-void game::move_tableau_to_tableau(uint8_t from, uint8_t to)
+bool game::has_auto_completion_finished() const noexcept
 {
-  if (from < TABLEAU_COUNT && to < TABLEAU_COUNT && from != to)
-  {
-    move_card(_tableaus[from].get_last(), _tableaus[to]);
-  }
+  return get_counters().foundation_cards == CARDS_COUNT;
 }
 
-bool parse_t_command(const std::string& cmd, int& a, int& b)
+bool game::has_available_moves() const noexcept
 {
-  if (cmd.size() == 3 && cmd[0] == 't' && std::isdigit(cmd[1]) &&
-      std::isdigit(cmd[2]))
-  {
-    a = cmd[1] - '0';
-    b = cmd[2] - '0';
-    return true;
-  }
-  return false;
+  return _availability.any();
 }
 
-void game::update()
+bool game::check_win() const noexcept
 {
-  print_board();
-  std::string command;
-  std::cin >> command;
+  const auto counters = get_counters();
+  return counters.stock_size == 0 && counters.face_down_cards == 0;
+}
 
-  if (command == "z")
-  {
-    undo_move();
-  }
-  else if (command == "n")
-  {
-    next_deck();
-  }
-  else if (command == "dt")
-  {
-    move_deck_to_tableau();
-  }
-  else if (command == "df")
+void game::update_status() noexcept
+{
+  if (_status == game_status::auto_solve)
   {
-    move_deck_to_foundation();
+    if (has_auto_completion_finished())
+    {
+      _status = game_status::won;
+    }
   }
-  else if (command[0] == 't')
+  else
   {
-    if (command == "tf")
-      move_tableau_to_foundation();
+    if (check_win())
+    {
+      _status = game_status::auto_solve;
+    }
     else
     {
-      int a = -1, b = -1;
-      if (parse_t_command(command, a, b)) move_tableau_to_tableau(a, b);
+      if (!has_available_moves())
+      {
+        _status = game_status::lost;
+      }
+      else
+      {
+        _status = game_status::in_progress;
+      }
     }
   }
-  else if (command == "p")
+
+  if (_status != _published_status)
   {
-    print_cards();
+    _published_status = _status;
+    emit(game_event{.type = game_event_type::status_changed,
+                    .status = _status});
   }
 }
-
-#pragma endregion
\ No newline at end of file
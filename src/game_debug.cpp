@@ -0,0 +1,210 @@
+#include <format>
+#include <iostream>
+#include <string>
+
+#include "console_card.h"
+#include "game.h"
+
+#pragma region Debug
+
+void game::print_cards() const
+{
+  std::cout << "-----Cards------" << std::endl;
+  for (const auto& card : _board.cards)
+  {
+    print_card(card, _board.face_up.contains(card.get_id()));
+  }
+}
+
+void game::print_board() const
+{
+  std::cout << "-----Tableau------" << std::endl;
+  for (int tIndex = 0; tIndex < TABLEAU_COUNT; tIndex++)
+  {
+    const auto& tableau = _board.tableaus[tIndex];
+    std::cout << std::format("Tableau{} has: {} cards. Top: ", tIndex,
+                             tableau.get_height());
+
+    if (!tableau.is_empty())
+    {
+      print_card(_board.cards[tableau.get_last()], true);
+    }
+    else
+    {
+      std::cout << "---" << std::endl;
+    }
+  }
+
+  std::cout << "-----Foundation------" << std::endl;
+  for (int fIndex = 0; fIndex < FOUNDATION_COUNT; fIndex++)
+  {
+    const auto& foundation = _board.foundations.at(fIndex);
+    std::cout << std::format("Foundation{} has: {} cards. Top: ", fIndex,
+                             foundation.get_height());
+
+    if (!foundation.is_empty())
+    {
+      print_card(_board.cards[foundation.get_last()], true);
+    }
+    else
+    {
+      std::cout << "---" << std::endl;
+    }
+  }
+
+  const auto current_deck = _board.waste_top();
+  std::cout << "-----Deck------" << std::endl;
+  std::cout << std::format(
+      "Deck has: {} cards. Waste {}. Passes {}. Current card: ",
+      _board.deck.get_height(), _board.waste_size, _board.passes);
+  if (current_deck != NO_CARD)
+  {
+    print_card(_board.cards[current_deck], true);
+  }
+  else
+  {
+    std::cout << "---" << std::endl;
+  }
+
+  std::cout << "----Moves----" << std::endl;
+  std::cout << std::format("MovesCount: {}", _history.size()) << std::endl;
+}
+
+void game::move_deck_to_tableau()
+{
+  const auto current_deck = _board.waste_top();
+
+  if (current_deck != NO_CARD)
+  {
+    int targetIndex = -1;
+
+    for (uint8_t t = 0; t < TABLEAU_COUNT; t++)
+    {
+      if (_board.is_valid_placement(_board.tableaus[t], current_deck))
+      {
+        targetIndex = t;
+        break;
+      }
+    }
+
+    if (targetIndex >= 0)
+    {
+      move_card(current_deck, _board.tableaus[targetIndex].get_id());
+    }
+  }
+}
+
+void game::move_deck_to_foundation()
+{
+  const auto current_deck = _board.waste_top();
+
+  if (current_deck != NO_CARD)
+  {
+    int foundationIndex = -1;
+
+    for (uint8_t i = 0; i < FOUNDATION_COUNT; i++)
+    {
+      if (_board.is_valid_placement(_board.foundations[i], current_deck))
+      {
+        foundationIndex = i;
+        break;
+      }
+    }
+
+    if (foundationIndex >= 0)
+    {
+      move_card(current_deck, _board.foundations[foundationIndex].get_id());
+    }
+  }
+}
+
+void game::move_tableau_to_foundation()
+{
+  uint8_t foundationIndex = 0;
+  uint8_t tableauIndex = 0;
+  bool found = false;
+
+  for (uint8_t t = 0; t < TABLEAU_COUNT && !found; t++)
+  {
+    const auto tableauCard = _board.tableaus[t].get_last();
+
+    if (tableauCard != NO_CARD)
+    {
+      for (uint8_t f = 0; f < FOUNDATION_COUNT && !found; f++)
+      {
+        if (_board.is_valid_placement(_board.foundations[f], tableauCard))
+        {
+          foundationIndex = f;
+          tableauIndex = t;
+          found = true;
+        }
+      }
+    }
+  }
+
+  if (found)
+  {
+    move_card(_board.tableaus[tableauIndex].get_last(),
+              _board.foundations[foundationIndex].get_id());
+  }
+}
+
+void game::move_tableau_to_tableau(uint8_t from, uint8_t to)
+{
+  if (from < TABLEAU_COUNT && to < TABLEAU_COUNT && from != to)
+  {
+    move_card(_board.tableaus[from].get_last(), _board.tableaus[to].get_id());
+  }
+}
+
+bool parse_t_command(const std::string& cmd, int& a, int& b)
+{
+  if (cmd.size() == 3 && cmd[0] == 't' && std::isdigit(cmd[1]) &&
+      std::isdigit(cmd[2]))
+  {
+    a = cmd[1] - '0';
+    b = cmd[2] - '0';
+    return true;
+  }
+  return false;
+}
+
+void game::update()
+{
+  print_board();
+  std::string command;
+  std::cin >> command;
+
+  if (command == "z")
+  {
+    undo_move();
+  }
+  else if (command == "n")
+  {
+    next_deck();
+  }
+  else if (command == "dt")
+  {
+    move_deck_to_tableau();
+  }
+  else if (command == "df")
+  {
+    move_deck_to_foundation();
+  }
+  else if (command[0] == 't')
+  {
+    if (command == "tf")
+      move_tableau_to_foundation();
+    else
+    {
+      int a = -1, b = -1;
+      if (parse_t_command(command, a, b)) move_tableau_to_tableau(a, b);
+    }
+  }
+  else if (command == "p")
+  {
+    print_cards();
+  }
+}
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "game_event_queue.h"
+
+void game_event_queue::push(const game_event& e) noexcept
+{
+  const auto tail = _tail.load(std::memory_order_relaxed);
+
+  if (tail - _head.load(std::memory_order_acquire) == CAPACITY)
+  {
+    _overflow.store(true, std::memory_order_release);
+    return;
+  }
+
+  _events[tail & (CAPACITY - 1)] = e;
+  _tail.store(tail + 1, std::memory_order_release);
+}
+
+std::optional<game_event> game_event_queue::pop() noexcept
+{
+  const auto head = _head.load(std::memory_order_relaxed);
+
+  if (head == _tail.load(std::memory_order_acquire))
+  {
+    return std::nullopt;
+  }
+
+  const auto e = _events[head & (CAPACITY - 1)];
+  _head.store(head + 1, std::memory_order_release);
+  return e;
+}
+
+bool game_event_queue::take_overflow() noexcept
+{
+  return _overflow.exchange(false, std::memory_order_acq_rel);
+}
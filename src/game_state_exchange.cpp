@@ -0,0 +1,19 @@
+#include "game_state_exchange.h"
+
+void game_state_exchange::publish(const game_state& state) noexcept
+{
+  _slots[_back] = state;
+  const auto previous =
+      _middle.exchange(_back | FRESH, std::memory_order_acq_rel);
+  _back = previous & INDEX_MASK;
+}
+
+const game_state& game_state_exchange::latest() noexcept
+{
+  if (_middle.load(std::memory_order_relaxed) & FRESH)
+  {
+    const auto previous = _middle.exchange(_front, std::memory_order_acq_rel);
+    _front = previous & INDEX_MASK;
+  }
+  return _slots[_front];
+}
@@ -2,6 +2,7 @@
 #include "drag_controller.h"
 #include "game.h"
 #include "game_state.h"
+#include "game_state_exchange.h"
 #include "hit_result.h"
 #include "renderer.h"
 
@@ -16,6 +17,7 @@ int main()
   game game;
   drag_controller drag;
   auto_move auto_move;
+  game_state_exchange exchange;
 
   renderer.register_button("New Game",
                            [&]()
@@ -26,11 +28,22 @@ int main()
                            });
 
   renderer.register_button("Undo move", [&]() { game.undo_move(); });
-  renderer.register_button("Show hint", [&]() { game.show_hint(); });
+  renderer.register_button("Redo move", [&]() { game.redo_move(); });
+  renderer.register_button("Show hint", [&]() { game.request_hint(); });
+
+  // the hint search gets half of each frame so the frame rate holds
+  const std::chrono::microseconds analysis_budget(
+      500'000 / renderer.get_refresh_rate());
 
   while (!renderer.should_close())
   {
-    game_state state = game.export_game_state();
+    // logic side: search for the hint, then publish the frame's snapshot
+    game.update_analysis(analysis_budget);
+    exchange.publish(game.export_game_state());
+
+    // render side: hit tests and drawing only read the published snapshot,
+    // so the logic side could move to its own thread unchanged
+    const game_state& state = exchange.latest();
     Vector2 mouse = GetMousePosition();
     auto drag_overlay = drag.overlay();
 
@@ -42,17 +55,19 @@ int main()
         if (move_data)
         {
           auto_move.move_data = move_data;
-          auto target_card = auto_move.move_data->moved_card;
-          auto target_pile = auto_move.move_data->to_pile;
+          const auto& layout = state.layout;
+          auto target_card = &layout.cards[auto_move.move_data->moved_card];
+          const auto& target_pile =
+              layout.get_pile(auto_move.move_data->to_pile);
 
           auto_move.from_pos =
-              middle_of_rect(renderer.card_rect_draw(target_card));
+              middle_of_rect(renderer.card_rect_draw(layout, target_card));
           auto_move.to_pos =
-              middle_of_rect(renderer.pile_rect_hit(*target_pile));
+              middle_of_rect(renderer.pile_rect_hit(layout, target_pile));
           auto_move.time_elapsed = 0.f;
 
-          drag.start(target_card, auto_move.from_pos,
-                     renderer.card_rect_draw(target_card));
+          drag.start(layout, target_card, auto_move.from_pos,
+                     renderer.card_rect_draw(layout, target_card));
         }
       }
       else
@@ -64,7 +79,9 @@ int main()
         }
         else
         {
-          drag.end(game, hit_result{.hit_pile = auto_move.move_data->to_pile});
+          drag.end(game, hit_result{.hit_card = nullptr,
+                                    .hit_pile = &state.layout.get_pile(
+                                        auto_move.move_data->to_pile)});
           auto_move.move_data = std::nullopt;
         }
       }
@@ -77,8 +94,8 @@ int main()
 
         if (hit.hit_card)
         {
-          drag.start(hit.hit_card, mouse,
-                     renderer.card_rect_draw(hit.hit_card));
+          drag.start(state.layout, hit.hit_card, mouse,
+                     renderer.card_rect_draw(state.layout, hit.hit_card));
         }
         else if (hit.hit_pile && hit.hit_pile->type == pile_type::deck)
         {
@@ -92,7 +109,7 @@ int main()
       else if (IsMouseButtonReleased(MOUSE_BUTTON_LEFT))
       {
         hit_result hit{.hit_card = nullptr, .hit_pile = nullptr};
-        if (drag_overlay && drag_overlay->root)
+        if (drag_overlay && drag_overlay->root != NO_CARD)
         {
           hit = renderer.hit_test_drag(state, *drag_overlay);
         }
@@ -104,6 +121,11 @@ int main()
       {
         game.undo_move();
       }
+
+      if (IsKeyPressed(KEY_Y))
+      {
+        game.redo_move();
+      }
     }
 
     if (IsKeyPressed(KEY_R))
@@ -113,9 +135,23 @@ int main()
       auto_move.move_data = std::nullopt;
     }
 
+    if (IsKeyPressed(KEY_D))
+    {
+      const auto rules = game.get_stock_rules();
+      game.set_stock_rules(rules == DRAW_ONE ? DRAW_THREE : DRAW_ONE);
+      game.new_game();
+      drag = drag_controller();
+      auto_move.move_data = std::nullopt;
+    }
+
     if (IsKeyPressed(KEY_H))
     {
-      game.show_hint();
+      game.request_hint();
+    }
+
+    if (IsKeyPressed(KEY_A))
+    {
+      game.set_auto_play(!game.get_auto_play());
     }
 
     if (IsKeyPressed(KEY_F))
@@ -0,0 +1,139 @@
+#include "move_availability.h"
+
+#include <bit>
+
+#include "board.h"
+#include "placement.h"
+
+
+void move_availability::rebuild(const board& b) noexcept
+{
+  for (pile_id p = 0; p < PILE_COUNT; p++)
+  {
+    update_pile(b, p);
+  }
+  for (pile_id p = 0; p < PILE_COUNT; p++)
+  {
+    update_row(p);
+  }
+  update_hint();
+}
+
+void move_availability::update(const board& b, pile_id from,
+                               pile_id to) noexcept
+{
+  update_pile(b, from);
+  update_pile(b, to);
+
+  update_row(from);
+  update_row(to);
+  update_column(from);
+  update_column(to);
+
+  update_hint();
+}
+
+void move_availability::update_pile(const board& b, pile_id p) noexcept
+{
+  const auto& current = b.get_pile(p);
+
+  _accepts[p] = valid_followers(current.type, current.get_last());
+  _offers_tableau[p] = card_set();
+  _offers_foundation[p] = card_set();
+
+  switch (current.type)
+  {
+    case pile_type::tableau:
+    {
+      // only chains uncovering a face-down card are worth moving
+      const auto hidden = b.pile_contents[p] & ~b.face_up;
+      if (!hidden.empty() && hidden.size() < current.get_height())
+      {
+        _offers_tableau[p] = card_set::of(current.at(hidden.size()));
+      }
+      if (!current.is_empty())
+      {
+        _offers_foundation[p] = card_set::of(current.get_last());
+      }
+      break;
+    }
+    case pile_type::deck:
+      _offers_tableau[p] = b.reachable_stock;
+      _offers_foundation[p] = b.reachable_stock;
+      break;
+    default:
+      break;
+  }
+}
+
+void move_availability::update_row(pile_id source) noexcept
+{
+  uint16_t targets = 0;
+
+  for (pile_id t = FIRST_TABLEAU_PILE; t < PILE_COUNT; t++)
+  {
+    const auto& offers = t < FIRST_FOUNDATION_PILE
+                             ? _offers_tableau[source]
+                             : _offers_foundation[source];
+    if (t != source && !(offers & _accepts[t]).empty())
+    {
+      targets |= 1u << t;
+    }
+  }
+
+  _targets[source] = targets;
+}
+
+void move_availability::update_column(pile_id target) noexcept
+{
+  const uint16_t bit = 1u << target;
+
+  for (pile_id s = 0; s < PILE_COUNT; s++)
+  {
+    const auto& offers = target < FIRST_FOUNDATION_PILE
+                             ? _offers_tableau[s]
+                             : _offers_foundation[s];
+    if (s != target && !(offers & _accepts[target]).empty())
+    {
+      _targets[s] |= bit;
+    }
+    else
+    {
+      _targets[s] &= ~bit;
+    }
+  }
+}
+
+void move_availability::update_hint() noexcept
+{
+  const auto make_hint = [&](pile_id source, uint16_t targets) -> hint
+  {
+    const auto target = static_cast<pile_id>(std::countr_zero(targets));
+    const auto& offers = target < FIRST_FOUNDATION_PILE
+                             ? _offers_tableau[source]
+                             : _offers_foundation[source];
+    return hint{.movable_card = (offers & _accepts[target]).first(),
+                .target_pile = target};
+  };
+
+  // tableau to tableau, then tableau to foundation, then deck
+  for (const auto mask : {TABLEAU_PILES, FOUNDATION_PILES})
+  {
+    for (pile_id s = FIRST_TABLEAU_PILE; s < FIRST_FOUNDATION_PILE; s++)
+    {
+      if (_targets[s] & mask)
+      {
+        _hint = make_hint(s, _targets[s] & mask);
+        return;
+      }
+    }
+  }
+
+  if (_targets[DECK_PILE])
+  {
+    _hint = make_hint(DECK_PILE, _targets[DECK_PILE]);
+    return;
+  }
+
+  _hint = std::nullopt;
+}
@@ -0,0 +1,120 @@
+#include "move_generator.h"
+
+#include <bit>
+
+#include "board.h"
+
+void generate_moves(const board& b, move_list& out) noexcept
+{
+  // moves are byte fields that could alias the board, so they are counted
+  // in a local and the count stored once at the end
+  move* next = out.moves.data();
+
+  card_set any_foundation_accepts;
+  for (const auto& f : b.foundations)
+  {
+    any_foundation_accepts |=
+        valid_followers(pile_type::foundation, f.get_last());
+  }
+
+  // tableaus whose top may go up, one bit per tableau index
+  card_set any_tableau_accepts;
+  uint8_t tops_going_up = 0;
+  for (uint8_t i = 0; i < TABLEAU_COUNT; i++)
+  {
+    const auto top = b.tableaus[i].get_last();
+    any_tableau_accepts |= valid_followers(pile_type::tableau, top);
+    tops_going_up |= (top != NO_CARD && any_foundation_accepts.contains(top))
+                     << i;
+  }
+
+  const auto push_to = [&](pile_mask targets, card_id c, pile_id from,
+                           uint8_t position, bool reveals)
+  {
+    targets &= target_mask(b.tops, c) & ~(1u << from);
+    while (targets)
+    {
+      const auto to = static_cast<pile_id>(std::countr_zero(targets));
+      targets &= targets - 1;
+      *next++ = move{c, from, to, position, reveals};
+    }
+  };
+
+  const auto push_to_tableaus = [&](card_id c, pile_id from, uint8_t position,
+                                    bool reveals)
+  { push_to(TABLEAU_PILES, c, from, position, reveals); };
+
+  const auto push_to_foundations =
+      [&](card_id c, pile_id from, uint8_t position, bool reveals)
+  { push_to(FOUNDATION_PILES, c, from, position, reveals); };
+
+  const auto is_hidden = [&](const pile& p, uint8_t position)
+  { return position > 0 && !b.face_up.contains(p.at(position - 1)); };
+
+  // tableau to tableau, a pile at a time in pile order
+  const auto chain_roots = b.face_up & any_tableau_accepts &
+                           ~b.pile_contents[DECK_PILE] & ~b.in_foundation;
+  pile_mask root_piles = 0;
+  for (auto roots = chain_roots; !roots.empty();)
+  {
+    root_piles |= 1u << b.cards[roots.pop_first()].owner;
+  }
+  while (root_piles)
+  {
+    const auto from = static_cast<pile_id>(std::countr_zero(root_piles));
+    root_piles &= root_piles - 1;
+    const auto& t = b.tableaus[from - FIRST_TABLEAU_PILE];
+    auto roots = b.pile_contents[from] & chain_roots;
+    while (!roots.empty())
+    {
+      const auto c = roots.pop_first();
+      const auto position = b.cards[c].position;
+      push_to_tableaus(c, from, position, is_hidden(t, position));
+    }
+  }
+
+  // tableau to foundation
+  while (tops_going_up)
+  {
+    const auto i = static_cast<uint8_t>(std::countr_zero(tops_going_up));
+    tops_going_up &= tops_going_up - 1;
+    const auto& t = b.tableaus[i];
+    const auto position = static_cast<uint8_t>(t.get_height() - 1);
+    push_to_foundations(t.get_last(), FIRST_TABLEAU_PILE + i, position,
+                        is_hidden(t, position));
+  }
+
+  // waste to tableau or foundation
+  const auto waste = b.waste_top();
+  if (waste != NO_CARD)
+  {
+    const auto position = b.cards[waste].position;
+    if (any_tableau_accepts.contains(waste))
+    {
+      push_to_tableaus(waste, DECK_PILE, position, false);
+    }
+    if (any_foundation_accepts.contains(waste))
+    {
+      push_to_foundations(waste, DECK_PILE, position, false);
+    }
+  }
+
+  // foundation to tableau
+  for (uint8_t i = 0; i < FOUNDATION_COUNT; i++)
+  {
+    const auto& f = b.foundations[i];
+    const auto top = f.get_last();
+    if (top != NO_CARD && any_tableau_accepts.contains(top))
+    {
+      push_to_tableaus(top, FIRST_FOUNDATION_PILE + i, f.get_height() - 1,
+                       false);
+    }
+  }
+
+  // stock advance
+  if (b.can_advance_stock())
+  {
+    *next++ = move{.from_pile = DECK_PILE, .to_pile = DECK_PILE};
+  }
+  out.count = static_cast<uint8_t>(next - out.moves.data());
+}
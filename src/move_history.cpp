@@ -0,0 +1,244 @@
+#include "move_history.h"
+
+#include <algorithm>
+
+move_history::move_history() : _nodes(CAPACITY), _line(CAPACITY)
+{
+  _checkpoints.reserve(CHECKPOINT_COUNT);
+}
+
+move_history::move_history(const move_history& other)
+    : _nodes(CAPACITY),
+      _line(CAPACITY),
+      _checkpoint_nodes(other._checkpoint_nodes),
+      _used(other._used),
+      _current(other._current),
+      _tip(other._tip),
+      _first(other._first)
+{
+  std::copy_n(other._nodes.begin(), _used, _nodes.begin());
+  std::copy_n(other._line.begin(), _tip + 1, _line.begin());
+  _checkpoints.reserve(CHECKPOINT_COUNT);
+  _checkpoints.assign(other._checkpoints.begin(), other._checkpoints.end());
+}
+
+move_history& move_history::operator=(const move_history& other)
+{
+  return *this = move_history(other);
+}
+
+void move_history::clear(const board& start) noexcept
+{
+  _nodes[ROOT] = node{};
+  _used = 1;
+  _current = ROOT;
+  _line[0] = ROOT;
+  _tip = 0;
+  _first = 0;
+
+  _checkpoint_nodes.fill(NO_NODE);
+  _checkpoints.assign(1, start);
+  _checkpoint_nodes[0] = ROOT;
+}
+
+void move_history::push(packed_move m, const board& after) noexcept
+{
+  // replaying a recorded move follows its branch
+  for (auto c = _nodes[_current].first_child; c != NO_NODE;
+       c = _nodes[c].next_sibling)
+  {
+    if (_nodes[c].move.bits() == m.bits())
+    {
+      enter(c);
+      save_checkpoint(after);
+      return;
+    }
+  }
+
+  if (_used == CAPACITY && !compact(after))
+  {
+    return;
+  }
+
+  const auto n = static_cast<history_node>(_used++);
+  auto& parent = _nodes[_current];
+  _nodes[n] = node{
+      .move = m,
+      .parent = _current,
+      .next_sibling = parent.first_child,
+      .depth = static_cast<uint16_t>(parent.depth + 1),
+  };
+  parent.first_child = n;
+
+  enter(n);
+  save_checkpoint(after);
+}
+
+std::optional<packed_move> move_history::undo() noexcept
+{
+  if (_current == ROOT)
+  {
+    return std::nullopt;
+  }
+
+  const auto m = _nodes[_current].move;
+  _current = _nodes[_current].parent;
+  return m;
+}
+
+std::optional<packed_move> move_history::redo() noexcept
+{
+  const auto depth = _nodes[_current].depth;
+  if (depth == _tip)
+  {
+    return std::nullopt;
+  }
+
+  _current = _line[depth + 1];
+  return _nodes[_current].move;
+}
+
+void move_history::save_checkpoint(const board& b) noexcept
+{
+  const auto depth = _nodes[_current].depth;
+  if (depth % CHECKPOINT_INTERVAL == 0)
+  {
+    // depths are reached one at a time, so a new slot is always the next one
+    const auto slot = depth / CHECKPOINT_INTERVAL;
+    if (slot == _checkpoints.size())
+    {
+      _checkpoints.push_back(b);
+    }
+    else
+    {
+      _checkpoints[slot] = b;
+    }
+    _checkpoint_nodes[slot] = _current;
+  }
+}
+
+size_t move_history::nearest_checkpoint(size_t position) const noexcept
+{
+  // the root always has a checkpoint, so the loop ends at slot 0
+  auto slot = (position - _first) / CHECKPOINT_INTERVAL;
+  while (_checkpoint_nodes[slot] != _line[slot * CHECKPOINT_INTERVAL])
+  {
+    slot--;
+  }
+  return _first + slot * CHECKPOINT_INTERVAL;
+}
+
+size_t move_history::select_branch(history_node n) noexcept
+{
+  // point every ancestor at the path to n until it joins the active line
+  auto child = n;
+  while (_nodes[child].depth > _tip || _line[_nodes[child].depth] != child)
+  {
+    _line[_nodes[child].depth] = child;
+    _nodes[_nodes[child].parent].redo_child = child;
+    child = _nodes[child].parent;
+  }
+  const auto shared = _nodes[child].depth;
+
+  // follow the last branch taken below n
+  _tip = _nodes[n].depth;
+  for (auto next = _nodes[n].redo_child; next != NO_NODE;
+       next = _nodes[next].redo_child)
+  {
+    _line[++_tip] = next;
+  }
+
+  return _first + shared;
+}
+
+void move_history::enter(history_node child) noexcept
+{
+  _nodes[_current].redo_child = child;
+  _current = child;
+
+  const auto depth = _nodes[child].depth;
+  if (depth > _tip || _line[depth] != child)
+  {
+    _line[depth] = child;
+    _tip = depth;
+    for (auto next = _nodes[child].redo_child; next != NO_NODE;
+         next = _nodes[next].redo_child)
+    {
+      _line[++_tip] = next;
+    }
+  }
+}
+
+bool move_history::compact(const board& after) noexcept
+{
+  const size_t depth = _nodes[_current].depth;
+
+  // the new root must have a checkpoint: use the oldest one that leaves
+  // room to grow, or the layout after the pending move if there is none
+  size_t root_depth = 0;
+  if (depth + 1 >= CAPACITY - CHECKPOINT_INTERVAL)
+  {
+    root_depth = depth + 1;
+    for (size_t slot = 1; slot * CHECKPOINT_INTERVAL <= depth; slot++)
+    {
+      if (_checkpoint_nodes[slot] == _line[slot * CHECKPOINT_INTERVAL])
+      {
+        root_depth = slot * CHECKPOINT_INTERVAL;
+        break;
+      }
+    }
+  }
+
+  if (root_depth > depth)
+  {
+    _first += root_depth;
+    _nodes[ROOT] = node{};
+    _used = 1;
+    _current = ROOT;
+    _line[0] = ROOT;
+    _tip = 0;
+    _checkpoint_nodes.fill(NO_NODE);
+    _checkpoints.assign(1, after);
+    _checkpoint_nodes[0] = ROOT;
+    return false;
+  }
+
+  // nodes are numbered after their parents, so the kept path can be moved to
+  // nodes 0..depth - root_depth in depth order without overwriting any node
+  // still to be moved
+  for (size_t d = root_depth; d <= depth; d++)
+  {
+    const auto i = static_cast<history_node>(d - root_depth);
+    const bool is_last = d == depth;
+    _nodes[i] = node{
+        .move = _nodes[_line[d]].move,
+        .parent = i == ROOT ? NO_NODE : static_cast<history_node>(i - 1),
+        .first_child = is_last ? NO_NODE : static_cast<history_node>(i + 1),
+        .redo_child = is_last ? NO_NODE : static_cast<history_node>(i + 1),
+        .depth = i,
+    };
+  }
+
+  for (size_t slot = 0; slot < CHECKPOINT_COUNT; slot++)
+  {
+    const auto d = root_depth + slot * CHECKPOINT_INTERVAL;
+    const bool is_valid =
+        d <= depth && _checkpoint_nodes[d / CHECKPOINT_INTERVAL] == _line[d];
+    if (is_valid && slot != d / CHECKPOINT_INTERVAL)
+    {
+      _checkpoints[slot] = _checkpoints[d / CHECKPOINT_INTERVAL];
+    }
+    _checkpoint_nodes[slot] =
+        is_valid ? static_cast<history_node>(d - root_depth) : NO_NODE;
+  }
+
+  _first += root_depth;
+  _used = depth - root_depth + 1;
+  _current = static_cast<history_node>(depth - root_depth);
+  _tip = _current;
+  for (history_node i = 0; i <= _current; i++)
+  {
+    _line[i] = i;
+  }
+  return true;
+}
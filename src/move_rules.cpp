@@ -0,0 +1,118 @@
+#include "move_rules.h"
+
+#include <algorithm>
+
+#include "board.h"
+
+bool is_legal(const board& b, const move& m) noexcept
+{
+  if (m.is_stock_advance())
+  {
+    return b.can_advance_stock();
+  }
+
+  if (m.moved_card >= CARDS_COUNT || m.to_pile >= PILE_COUNT)
+  {
+    return false;
+  }
+
+  // only the top of a foundation may leave it, the cards below stay
+  const auto owner = b.cards[m.moved_card].owner;
+  const bool is_movable =
+      owner == DECK_PILE ? m.moved_card == b.waste_top()
+      : type_of(owner) == pile_type::foundation
+          ? b.get_pile(owner).get_last() == m.moved_card
+          : b.face_up.contains(m.moved_card);
+  return owner != NO_PILE && is_movable &&
+         b.is_valid_placement(b.get_pile(m.to_pile), m.moved_card);
+}
+
+void advance_deck(board& b) noexcept
+{
+  const auto height = b.deck.get_height();
+
+  if (b.waste_size < height)
+  {
+    b.set_waste_size(
+        static_cast<uint8_t>(std::min(b.waste_size + b.stock.draw_count,
+                                      static_cast<int>(height))));
+  }
+  else
+  {
+    // the stock is empty: turn the waste over
+    if (b.stock.pass_limit != UNLIMITED_PASSES)
+    {
+      b.set_passes(b.passes + 1);
+    }
+    b.set_waste_size(0);
+  }
+}
+
+packed_move apply_move(board& b, card_id moved, pile_id target) noexcept
+{
+  const auto& moved_card = b.cards[moved];
+  const auto from = moved_card.owner;
+  const auto from_position = moved_card.position;
+  const auto deck_cursor = b.get_deck_cursor();
+  const bool is_from_deck = type_of(from) == pile_type::deck;
+  const uint8_t depth =
+      is_from_deck ? 1 : b.get_pile(from).get_height() - from_position;
+  bool revealed = false;
+
+  if (is_from_deck)
+  {
+    // the card below becomes the waste top, the moved card stays face up
+    b.set_waste_size(b.waste_size - 1);
+    b.set_face_up(moved, true);
+  }
+  else
+  {
+    const auto moved_parent = b.get_parent(moved);
+    if (moved_parent != NO_CARD && !b.face_up.contains(moved_parent))
+    {
+      b.set_face_up(moved_parent, true);
+      revealed = true;
+    }
+  }
+
+  b.splice(moved, b.get_pile(target));
+
+  return packed_move(from, target, from_position, depth, revealed,
+                     deck_cursor);
+}
+
+void replay_move(board& b, packed_move m) noexcept
+{
+  if (m.is_stock_advance())
+  {
+    advance_deck(b);
+  }
+  else
+  {
+    apply_move(b, b.get_pile(m.from_pile()).at(m.from_position()),
+               m.to_pile());
+  }
+}
+
+void revert_move(board& b, packed_move m) noexcept
+{
+  if (!m.is_stock_advance())
+  {
+    const auto& to_pile = b.get_pile(m.to_pile());
+    auto& from_pile = b.get_pile(m.from_pile());
+    const auto moved_card = to_pile.at(to_pile.get_height() - m.depth());
+
+    if (from_pile.type == pile_type::deck)
+    {
+      b.set_face_up(moved_card, false);
+    }
+    b.splice(moved_card, from_pile, m.from_position());
+
+    if (m.revealed_card())
+    {
+      b.set_face_up(b.get_parent(moved_card), false);
+    }
+  }
+
+  b.set_deck_cursor(m.deck_cursor());
+}
@@ -1,176 +1,47 @@
 #include "pile.h"
 
+#include <algorithm>
+
 #include "card.h"
+#include "placement.h"
 
-uint8_t pile::get_height() const noexcept
+uint8_t pile::get_position_in_pile(const card& c) const noexcept
 {
-  uint8_t height = 0;
-
-  for (auto it = first; it; it = it->next)
-  {
-    height++;
-  }
-
-  return height;
+  return c.owner == get_id() ? c.position : NO_POSITION;
 }
 
-int8_t pile::get_position_in_pile(const card *c) const noexcept
+void pile::erase_from_pile(uint8_t position, uint8_t count) noexcept
 {
-  int8_t index = 0;
-  for (auto card = first; card; card = card->next)
+  if (position < _height)
   {
-    if (card == c) return index;
-    index++;
+    count = std::min<uint8_t>(count, _height - position);
+    std::copy(_cards.begin() + position + count, _cards.begin() + _height,
+              _cards.begin() + position);
+    _height -= count;
   }
-  return -1;
 }
 
-void pile::erase_from_pile(card *c) noexcept
+bool pile::is_valid_placement(const card& c) const noexcept
 {
-  if (c && !is_empty() && c->owner == this)
-  {
-    auto c_parent = c->get_parent();
-    bool is_deck = type == pile_type::deck;
-
-    if (c_parent)
-    {
-      c_parent->next = is_deck ? c->next : nullptr;
-    }
-    else
-    {
-      first = is_deck ? first->next : nullptr;
-    }
-
-    c->owner = nullptr;
-    if (is_deck)
-    {
-      c->next = nullptr;
-    }
-    else
-    {
-      for (auto it = c->next; it; it = it->next)
-      {
-        it->owner = nullptr;
-      }
-    }
-
-    update_last();
-  }
-}
-
-bool pile::is_valid_placement(const card *c) const noexcept
-{
-  if (c)
-  {
-    if (is_empty())
-    {
-      switch (type)
-      {
-        case pile_type::tableau:
-          return c->get_value() == card_value::King;
-        case pile_type::foundation:
-          return c->get_value() == card_value::Ace;
-        default:
-          break;
-      }
-    }
-    else
-    {
-      return get_last()->is_valid_placement(c);
-    }
-  }
-  return false;
+  return valid_followers(type, get_last()).contains(c.get_id());
 }
 
-void pile::assign_as_child(card *c) noexcept
+void pile::assign_as_child(const card_id* chain, uint8_t count) noexcept
 {
-  if (c && c->owner != this)
-  {
-    card *c_last = nullptr;
-
-    for (auto it = c; it; it = it->next)
-    {
-      it->owner = this;
-
-      if (!it->next)
-      {
-        c_last = it;
-      }
-    }
-
-    if (is_empty())
-    {
-      first = c;
-    }
-    else
-    {
-      last->next = c;
-    }
-
-    last = c_last;
-  }
+  assign_as_child(chain, count, _height);
 }
 
-void pile::assign_as_child(card *c, card *parent) noexcept
+void pile::assign_as_child(const card_id* chain, uint8_t count,
+                           uint8_t position) noexcept
 {
-  if (c && c->owner != this)
+  if (chain && count && position <= _height &&
+      _height + count <= PILE_CAPACITY)
   {
-    auto is_from_deck = type == pile_type::deck;
-    card *c_last = nullptr;
-    for (auto it = c; it; it = it->next)
-    {
-      it->owner = this;
-
-      if (!it->next)
-      {
-        c_last = it;
-      }
-    }
-
-    if (parent && parent->owner == this)
-    {
-      auto current_child = parent->next;
-
-      parent->next = c;
-      if (current_child)
-      {
-        if (c_last)
-        {
-          c_last->next = current_child;
-        }
-        else
-        {
-          c->next = current_child;
-        }
-      }
-    }
-    else if (is_from_deck)
-    {
-      if (!is_empty())
-      {
-        c->next = first;
-      }
-      first = c;
-    }
-
-    update_last();
+    std::copy_backward(_cards.begin() + position, _cards.begin() + _height,
+                       _cards.begin() + _height + count);
+    std::copy(chain, chain + count, _cards.begin() + position);
+    _height += count;
   }
 }
 
-void pile::reset() noexcept
-{
-  last = nullptr;
-  first = nullptr;
-}
-
-void pile::update_last() noexcept
-{
-  auto it = first;
-
-  while (it && it->next)
-  {
-    it = it->next;
-  }
-
-  last = it;
-}
+void pile::reset() noexcept { _height = 0; }
@@ -0,0 +1,42 @@
+#include "position_key.h"
+
+#include "board.h"
+
+position_key make_position_key(const board& b) noexcept
+{
+  position_key key;
+  key.bytes.fill(NO_CARD);
+
+  for (uint8_t f = 0; f < FOUNDATION_COUNT; f++)
+  {
+    key.bytes[position_key::FOUNDATION_OFFSET + f] =
+        b.foundations[f].get_last();
+  }
+
+  uint8_t next = position_key::CARDS_OFFSET;
+  for (uint8_t t = 0; t < TABLEAU_COUNT; t++)
+  {
+    const auto& tableau = b.tableaus[t];
+    uint8_t face_down = 0;
+
+    for (const auto id : tableau)
+    {
+      face_down += !b.face_up.contains(id);
+      key.bytes[next++] = id;
+    }
+
+    key.bytes[position_key::TABLEAU_OFFSET + t] =
+        static_cast<uint8_t>(tableau.get_height() << 3 | face_down);
+  }
+
+  for (const auto id : b.deck)
+  {
+    key.bytes[next++] = id;
+  }
+
+  key.bytes[position_key::DECK_OFFSET] = b.deck.get_height();
+  key.bytes[position_key::DECK_OFFSET + 1] = b.waste_size;
+  key.bytes[position_key::DECK_OFFSET + 2] = b.passes;
+
+  return key;
+}
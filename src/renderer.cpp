@@ -81,6 +81,7 @@ void renderer::update(const game_state& state, Vector2 mouse_pos,
 {
   update_scale();
   float margin = get_scaled_margin();
+  const auto& layout = state.layout;
 
   BeginDrawing();
   ClearBackground(Color{22, 120, 80, 255});
@@ -88,78 +89,81 @@ void renderer::update(const game_state& state, Vector2 mouse_pos,
   // Drop target test
   const pile* drop_pile = nullptr;
   bool drop_valid = false;
-  if (drag && drag->root)
+  if (drag && drag->root != NO_CARD)
   {
     auto hit = hit_test_drag(state, *drag);
 
     if (hit.hit_pile)
       drop_pile = hit.hit_pile;
     else if (hit.hit_card)
-      drop_pile = hit.hit_card->owner;
+      drop_pile = &layout.get_pile(hit.hit_card->owner);
 
     if (drop_pile)
     {
-      drop_valid = drop_pile->is_valid_placement(const_cast<card*>(drag->root));
+      drop_valid = layout.is_valid_placement(*drop_pile, drag->root);
     }
   }
 
   // Foundations
-  for (const auto& f : state.foundations)
+  for (const auto& f : layout.foundations)
   {
     if (!f.is_empty())
     {
       // Top 2 cards
-      auto top_card = f.get_last();
-      auto top_parent_card = top_card->get_parent();
+      auto top_card = &layout.cards[f.get_last()];
+      auto top_parent_card = layout.get_parent(f.get_last());
 
-      if (top_parent_card)
+      if (top_parent_card != NO_CARD)
       {
-        draw_card(top_parent_card);
+        draw_card(layout, &layout.cards[top_parent_card]);
       }
-      if (!(drag && in_drag_chain(drag->root, top_card)))
+      if (!(in_drag_chain(drag, top_card->get_id())))
       {
-        draw_card(top_card);
+        draw_card(layout, top_card);
       }
     }
-    DrawRectangleRoundedLines(pile_rect_hit(f), 0.1f, 16, YELLOW);
+    DrawRectangleRoundedLines(pile_rect_hit(layout, f), 0.1f, 16, YELLOW);
   }
 
   // Tableaus
-  for (const auto& t : state.tableaus)
+  for (const auto& t : layout.tableaus)
   {
     if (!t.is_empty())
     {
-      for (auto c = t.get_first(); c; c = c->next)
+      for (const auto id : t)
       {
-        if (drag && in_drag_chain(drag->root, c)) continue;
-        draw_card(c);
+        auto c = &layout.cards[id];
+        if (in_drag_chain(drag, id)) continue;
+        draw_card(layout, c);
       }
     }
-    DrawRectangleRoundedLines(pile_rect_hit(t), 0.1f, 16, YELLOW);
+    DrawRectangleRoundedLines(pile_rect_hit(layout, t), 0.1f, 16, YELLOW);
   }
 
   // Deck
-  if (!state.deck.is_empty())
+  if (!layout.deck.is_empty())
   {
-    for (auto c = state.deck.get_first(); c; c = c->next)
+    for (const auto id : layout.deck)
     {
-      if (drag && in_drag_chain(drag->root, c)) continue;
-      draw_card(c);
+      auto c = &layout.cards[id];
+      if (in_drag_chain(drag, id)) continue;
+      draw_card(layout, c);
     }
   }
 
   // Piles
-  DrawRectangleRoundedLines(pile_rect_hit(state.deck), 0.1f, 16, YELLOW);
+  DrawRectangleRoundedLines(pile_rect_hit(layout, layout.deck), 0.1f, 16,
+                            YELLOW);
 
   // Highlight drop
   if (drop_pile)
   {
-    auto pile_rect = pile_rect_hit(*drop_pile);
+    auto pile_rect = pile_rect_hit(layout, *drop_pile);
     DrawRectangleRoundedLines(pile_rect, 0.1f, 16, drop_valid ? GREEN : RED);
   }
 
   // Dragged chain
-  if (drag && drag->root)
+  if (drag && drag->root != NO_CARD)
   {
     auto card_size = get_scaled_card_size();
     auto tableau_spacing = get_scaled_tableau_spacing();
@@ -170,22 +174,28 @@ void renderer::update(const game_state& state, Vector2 mouse_pos,
         .width = card_size.x,
         .height = card_size.y,
     };
-    for (auto c = drag->root; c; c = c->next)
+    for (auto id = drag->root; id != NO_CARD;
+         id = layout.get_child(id))
     {
-      draw_card(c, cr);
-      if (c->owner->type == pile_type::deck) break;
+      const auto c = &layout.cards[id];
+      draw_card(c, cr, true);
+      if (type_of(c->owner) == pile_type::deck) break;
       cr.y += tableau_spacing.y;
     }
   }
 
   // HUD
-  DrawText(TextFormat(_hud_message, state.moves.size()), margin,
-           GetScreenHeight() - 60, 20, YELLOW);
+  DrawText(TextFormat(_hud_message,
+                      static_cast<unsigned long long>(state.deal_number),
+                      static_cast<unsigned>(state.move_count),
+                      static_cast<unsigned>(state.counters.foundation_cards),
+                      static_cast<unsigned>(CARDS_COUNT)),
+           margin, GetScreenHeight() - 60, 20, YELLOW);
 
   // Hint
   if (state.next_move_hint)
   {
-    draw_hint(state.next_move_hint.value());
+    draw_hint(layout, state.next_move_hint.value());
   }
 
   draw_endgame_text(state.status);
@@ -266,21 +276,26 @@ Rectangle renderer::get_button_rect(size_t button_index) const noexcept
   };
 }
 
-void renderer::draw_hint(const hint valid_hint) noexcept
+void renderer::draw_hint(const board& layout, const hint valid_hint) noexcept
 {
-  if (valid_hint.movable_card && valid_hint.movable_card->owner &&
-      valid_hint.target_pile)
+  if (valid_hint.movable_card != NO_CARD &&
+      layout.cards[valid_hint.movable_card].owner != NO_PILE &&
+      valid_hint.target_pile != NO_PILE)
   {
-    DrawRectangleRoundedLinesEx(pile_rect_hit(*valid_hint.movable_card->owner),
-                                0.1f, 16, 2.f, BLUE);
-    DrawRectangleRoundedLinesEx(pile_rect_hit(*valid_hint.target_pile), 0.01f,
-                                16, 2.f, BLUE);
+    const auto& movable_card = layout.cards[valid_hint.movable_card];
+    const auto& target_pile = layout.get_pile(valid_hint.target_pile);
 
-    card_suit movable_suite = valid_hint.movable_card->get_suit();
+    DrawRectangleRoundedLinesEx(
+        pile_rect_hit(layout, layout.get_pile(movable_card.owner)), 0.1f, 16,
+        2.f, BLUE);
+    DrawRectangleRoundedLinesEx(pile_rect_hit(layout, target_pile), 0.01f, 16,
+                                2.f, BLUE);
+
+    card_suit movable_suite = movable_card.get_suit();
     Color movable_color =
         is_same_color(movable_suite, card_suit::Diamonds) ? RED : BLACK;
-    auto movable_message = TextFormat(
-        "Move %s", to_string_char(valid_hint.movable_card->get_value()));
+    auto movable_message =
+        TextFormat("Move %s", to_string_char(movable_card.get_value()));
     DrawText(movable_message,
              GetScreenWidth() * 0.95f - MeasureText(movable_message, 26),
              GetScreenHeight() * 0.4f, 24, movable_color);
@@ -288,14 +303,14 @@ void renderer::draw_hint(const hint valid_hint) noexcept
                {GetScreenWidth() * 0.95f, GetScreenHeight() * 0.4f}, 24, 2,
                movable_color);
 
-    card* target_card = valid_hint.target_pile->get_last();
-    if (target_card)
+    if (!target_pile.is_empty())
     {
-      card_suit target_suite = target_card->get_suit();
+      const auto& target_card = layout.cards[target_pile.get_last()];
+      card_suit target_suite = target_card.get_suit();
       Color target_color =
           is_same_color(target_suite, card_suit::Diamonds) ? RED : BLACK;
       auto target_message =
-          TextFormat("To %s", to_string_char(target_card->get_value()));
+          TextFormat("To %s", to_string_char(target_card.get_value()));
       DrawText(target_message,
                GetScreenWidth() * 0.95f - MeasureText(target_message, 26),
                GetScreenHeight() * 0.44f, 24, target_color);
@@ -309,44 +324,48 @@ void renderer::draw_hint(const hint valid_hint) noexcept
 hit_result renderer::hit_test(const game_state& state,
                               Vector2 mouse_pos) const noexcept
 {
-  if (state.current_deck)
+  const auto& layout = state.layout;
+
+  if (layout.waste_top() != NO_CARD)
   {
-    if (hit_test_card(state.current_deck, mouse_pos))
+    const auto current_deck = &layout.cards[layout.waste_top()];
+    if (hit_test_card(layout, current_deck, mouse_pos))
     {
-      return hit_result{.hit_card = state.current_deck, .hit_pile = nullptr};
+      return hit_result{.hit_card = current_deck, .hit_pile = nullptr};
     }
   }
 
   {
-    Rectangle stock = pile_rect_hit(state.deck);
+    Rectangle stock = pile_rect_hit(layout, layout.deck);
     if (CheckCollisionPointRec(mouse_pos, stock))
     {
-      return hit_result{.hit_card = nullptr, .hit_pile = &state.deck};
+      return hit_result{.hit_card = nullptr, .hit_pile = &layout.deck};
     }
   }
 
-  for (auto& f : state.foundations)
+  for (auto& f : layout.foundations)
   {
-    if (CheckCollisionPointRec(mouse_pos, pile_rect_hit(f)))
+    if (CheckCollisionPointRec(mouse_pos, pile_rect_hit(layout, f)))
     {
       if (!f.is_empty())
       {
-        return hit_result{.hit_card = f.get_last(), .hit_pile = nullptr};
+        return hit_result{.hit_card = &layout.cards[f.get_last()],
+                          .hit_pile = nullptr};
       }
 
       return hit_result{.hit_card = nullptr, .hit_pile = &f};
     }
   }
 
-  pile* empty_tableau_slot = nullptr;
-  card* target_card = nullptr;
+  const pile* empty_tableau_slot = nullptr;
+  const card* target_card = nullptr;
 
   for (uint8_t t_index = 0;
        t_index < TABLEAU_COUNT && !empty_tableau_slot && !target_card;
        t_index++)
   {
-    auto& t = state.tableaus[t_index];
-    Rectangle col = pile_rect_hit(t);
+    auto& t = layout.tableaus[t_index];
+    Rectangle col = pile_rect_hit(layout, t);
 
     if (t.is_empty())
     {
@@ -357,11 +376,11 @@ hit_result renderer::hit_test(const game_state& state,
       continue;
     }
 
-    for (card* c = t.get_first(); c; c = c->next)
+    for (const auto id : t)
     {
-      if (hit_test_card(c, mouse_pos))
+      if (hit_test_card(layout, &layout.cards[id], mouse_pos))
       {
-        target_card = c;
+        target_card = &layout.cards[id];
         break;
       }
     }
@@ -382,31 +401,35 @@ hit_result renderer::hit_test(const game_state& state,
 hit_result renderer::hit_test_rect(const game_state& state,
                                    Rectangle rect) const noexcept
 {
-  if (state.current_deck)
+  const auto& layout = state.layout;
+
+  if (layout.waste_top() != NO_CARD)
   {
-    if (CheckCollisionRecs(rect, card_rect_hit(state.current_deck)))
+    const auto current_deck = &layout.cards[layout.waste_top()];
+    if (CheckCollisionRecs(rect, card_rect_hit(layout, current_deck)))
     {
-      return hit_result{.hit_card = state.current_deck, .hit_pile = nullptr};
+      return hit_result{.hit_card = current_deck, .hit_pile = nullptr};
     }
   }
 
   {
-    Rectangle stock = pile_rect_hit(state.deck);
+    Rectangle stock = pile_rect_hit(layout, layout.deck);
     if (CheckCollisionRecs(rect, stock))
     {
-      return hit_result{.hit_card = nullptr, .hit_pile = &state.deck};
+      return hit_result{.hit_card = nullptr, .hit_pile = &layout.deck};
     }
   }
 
-  for (auto& f : state.foundations)
+  for (auto& f : layout.foundations)
   {
-    Rectangle frect = pile_rect_hit(f);
+    Rectangle frect = pile_rect_hit(layout, f);
     if (CheckCollisionRecs(rect, frect))
     {
       if (!f.is_empty())
       {
-        if (CheckCollisionRecs(rect, card_rect_hit(f.get_last())))
-          return hit_result{.hit_card = f.get_last(), .hit_pile = nullptr};
+        const auto top = &layout.cards[f.get_last()];
+        if (CheckCollisionRecs(rect, card_rect_hit(layout, top)))
+          return hit_result{.hit_card = top, .hit_pile = nullptr};
 
         return hit_result{.hit_card = nullptr, .hit_pile = &f};
       }
@@ -414,15 +437,15 @@ hit_result renderer::hit_test_rect(const game_state& state,
     }
   }
 
-  pile* empty_tableau_slot = nullptr;
-  card* target_card = nullptr;
+  const pile* empty_tableau_slot = nullptr;
+  const card* target_card = nullptr;
 
   for (uint8_t t_index = 0;
        t_index < TABLEAU_COUNT && !empty_tableau_slot && !target_card;
        t_index++)
   {
-    auto& t = state.tableaus[t_index];
-    Rectangle col = pile_rect_hit(t);
+    auto& t = layout.tableaus[t_index];
+    Rectangle col = pile_rect_hit(layout, t);
 
     if (t.is_empty())
     {
@@ -433,11 +456,11 @@ hit_result renderer::hit_test_rect(const game_state& state,
       continue;
     }
 
-    for (card* c = t.get_first(); c; c = c->next)
+    for (const auto id : t)
     {
-      if (CheckCollisionRecs(rect, card_rect_hit(c)))
+      if (CheckCollisionRecs(rect, card_rect_hit(layout, &layout.cards[id])))
       {
-        target_card = c;
+        target_card = &layout.cards[id];
         break;
       }
     }
@@ -459,12 +482,14 @@ hit_result renderer::hit_test_drag(const game_state& state,
 
 bool renderer::should_close() const noexcept { return WindowShouldClose(); }
 
-Vector2 renderer::stationary_card_pos(const card* c) const noexcept
+Vector2 renderer::stationary_card_pos(const board& layout,
+                                      const card* c) const noexcept
 {
-  if (c && c->owner)
+  if (c && c->owner != NO_PILE)
   {
-    auto pile_index = c->owner->index;
-    auto in_pile_index = c->owner->get_position_in_pile(c);
+    const auto& owner = layout.get_pile(c->owner);
+    auto pile_index = owner.index;
+    auto in_pile_index = c->position;
     auto card_size = get_scaled_card_size();
     auto margin_scaled = get_scaled_margin();
     auto foundation_size = get_scaled_foundation_spacing();
@@ -472,7 +497,7 @@ Vector2 renderer::stationary_card_pos(const card* c) const noexcept
     auto tablueau_offest = get_scaled_tableau_offset();
     auto deck_size = get_scaled_deck_spacing();
 
-    switch (c->owner->type)
+    switch (owner.type)
     {
       case pile_type::foundation:
         return Vector2{
@@ -491,12 +516,24 @@ Vector2 renderer::stationary_card_pos(const card* c) const noexcept
         };
 
       case pile_type::deck:
+      {
+        // the cards of the last draw are fanned out on the waste
+        const auto waste_size = layout.waste_size;
+        if (in_pile_index < waste_size)
+        {
+          const auto fanned =
+              std::max(0, in_pile_index + layout.stock.draw_count - waste_size);
+          return Vector2{
+              .x = margin_scaled + card_size.x + deck_size.x +
+                   fanned * deck_size.x,
+              .y = margin_scaled,
+          };
+        }
         return Vector2{
-            .x = c->face_up ? margin_scaled + card_size.x + deck_size.x
-                            : margin_scaled,
-            .y = c->face_up ? margin_scaled
-                            : margin_scaled + in_pile_index * deck_size.y,
+            .x = margin_scaled,
+            .y = margin_scaled + (in_pile_index - waste_size) * deck_size.y,
         };
+      }
       default:
         break;
     }
@@ -505,11 +542,12 @@ Vector2 renderer::stationary_card_pos(const card* c) const noexcept
   return Vector2();
 }
 
-Rectangle renderer::card_rect_draw(const card* c) const noexcept
+Rectangle renderer::card_rect_draw(const board& layout,
+                                   const card* c) const noexcept
 {
   if (c)
   {
-    auto cpos = stationary_card_pos(c);
+    auto cpos = stationary_card_pos(layout, c);
     auto card_size = get_scaled_card_size();
 
     return Rectangle{
@@ -523,14 +561,16 @@ Rectangle renderer::card_rect_draw(const card* c) const noexcept
   return Rectangle();
 }
 
-Rectangle renderer::card_rect_hit(const card* c) const noexcept
+Rectangle renderer::card_rect_hit(const board& layout,
+                                  const card* c) const noexcept
 {
   if (c)
   {
-    auto base_card_rect = card_rect_draw(c);
+    auto base_card_rect = card_rect_draw(layout, c);
     auto tableau_spacing = get_scaled_tableau_spacing();
 
-    if (c->next && c->owner && c->owner->type == pile_type::tableau)
+    if (type_of(c->owner) == pile_type::tableau &&
+        layout.get_child(c->get_id()) != NO_CARD)
     {
       base_card_rect.height = tableau_spacing.y;
     }
@@ -541,7 +581,8 @@ Rectangle renderer::card_rect_hit(const card* c) const noexcept
   return Rectangle{};
 }
 
-Rectangle renderer::pile_rect_hit(const pile& p) const noexcept
+Rectangle renderer::pile_rect_hit(const board& layout,
+                                  const pile& p) const noexcept
 {
   auto last_card = p.get_last();
   auto card_size = get_scaled_card_size();
@@ -551,9 +592,9 @@ Rectangle renderer::pile_rect_hit(const pile& p) const noexcept
   auto foundation_spacing = get_scaled_tableau_spacing();
   auto deck_spacing = get_scaled_deck_spacing();
 
-  if (last_card && p.type != pile_type::deck)
+  if (last_card != NO_CARD && p.type != pile_type::deck)
   {
-    return card_rect_hit(p.get_last());
+    return card_rect_hit(layout, &layout.cards[last_card]);
   }
   Rectangle rec{
       .width = card_size.x,
@@ -575,7 +616,9 @@ Rectangle renderer::pile_rect_hit(const pile& p) const noexcept
       break;
     case pile_type::deck:
       rec.x = scaled_margin;
-      rec.y = std::max(0, p.get_height() - 1) * deck_spacing.y + scaled_margin;
+      rec.y = std::max(0, p.get_height() - layout.waste_size - 1) *
+                  deck_spacing.y +
+              scaled_margin;
       break;
     default:
       break;
@@ -610,34 +653,38 @@ Rectangle renderer::drag_rect(const drag_overlay& drag) const noexcept
   };
 }
 
-bool renderer::hit_test_card(const card* c, Vector2 mouse_pos) const noexcept
+bool renderer::hit_test_card(const board& layout, const card* c,
+                             Vector2 mouse_pos) const noexcept
 {
-  if (c && c->face_up)
+  if (c && layout.face_up.contains(c->get_id()))
   {
-    return CheckCollisionPointRec(mouse_pos, card_rect_hit(c));
+    return CheckCollisionPointRec(mouse_pos, card_rect_hit(layout, c));
   }
   return false;
 }
 
-void renderer::draw_card(const card* c) noexcept
+void renderer::draw_card(const board& layout, const card* c) noexcept
 {
   if (c)
   {
-    draw_card(c, card_rect_draw(c));
+    // waste cards show their face even below the playable top
+    draw_card(c, card_rect_draw(layout, c),
+              layout.face_up.contains(c->get_id()) ||
+                  layout.is_in_waste(c->get_id()));
   }
 }
 
-void renderer::draw_card(const card* c, Rectangle cr) noexcept
+void renderer::draw_card(const card* c, Rectangle cr, bool face_up) noexcept
 {
   if (c)
   {
     if (_cards_tex.id == 0)
     {
-      Color back = c->face_up ? RAYWHITE : DARKBLUE;
+      Color back = face_up ? RAYWHITE : DARKBLUE;
       DrawRectangleRounded(cr, 0.08f, 6, back);
       DrawRectangleRoundedLines(cr, 0.08f, 6, DARKGRAY);
 
-      if (c->face_up)
+      if (face_up)
       {
         DrawText(TextFormat("%s", to_string(*c).c_str()),
                  static_cast<int>(cr.x + 8), static_cast<int>(cr.y + 6), 18,
@@ -646,15 +693,15 @@ void renderer::draw_card(const card* c, Rectangle cr) noexcept
     }
     else
     {
-      DrawTexturePro(_cards_tex, src_card_rect(c), cr, Vector2{0, 0}, 0.0f,
+      DrawTexturePro(_cards_tex, src_card_rect(c, face_up), cr, Vector2{0, 0}, 0.0f,
                      WHITE);
     }
   }
 }
 
-Rectangle renderer::src_card_rect(const card* c) const noexcept
+Rectangle renderer::src_card_rect(const card* c, bool face_up) const noexcept
 {
-  if (c && c->face_up)
+  if (c && face_up)
   {
     const uint8_t col = static_cast<uint8_t>(c->get_value()) - 1;
     const uint8_t row = static_cast<uint8_t>(c->get_suit());
@@ -677,13 +724,8 @@ Rectangle renderer::src_card_rect(const card* c) const noexcept
   }
 }
 
-bool renderer::in_drag_chain(const card* drag_root,
-                             const card* c) const noexcept
+bool renderer::in_drag_chain(const std::optional<drag_overlay>& drag,
+                             card_id c) const noexcept
 {
-  if (!drag_root || !c) return false;
-  if (drag_root->owner && drag_root->owner->type == pile_type::deck)
-    return c == drag_root;
-  for (auto it = drag_root; it; it = it->next)
-    if (it == c) return true;
-  return false;
+  return drag && drag->chain.contains(c);
 }
@@ -0,0 +1,82 @@
+#include "safe_moves.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "board.h"
+#include "card.h"
+
+/// @return Number of cards of suit s on the foundations
+static int foundation_rank(const board& b, card_suit s) noexcept
+{
+  return (b.in_foundation & card_set::suit(static_cast<uint8_t>(s))).size();
+}
+
+bool is_safe_foundation_card(const board& b, card_id c) noexcept
+{
+  const auto face = card::from_id(c);
+  const int rank = static_cast<int>(face.get_value());
+  if (rank <= 2)
+  {
+    return true;
+  }
+
+  // suits alternate colors: spades, hearts, clubs, diamonds
+  const auto suit = static_cast<uint8_t>(face.get_suit());
+  const int opposite = std::min(
+      foundation_rank(b, static_cast<card_suit>((suit + 1) % COLOR_COUNT)),
+      foundation_rank(b, static_cast<card_suit>((suit + 3) % COLOR_COUNT)));
+  const int same_color =
+      foundation_rank(b, static_cast<card_suit>((suit + 2) % COLOR_COUNT));
+
+  return opposite >= rank - 1 ||
+         (opposite >= rank - 2 && same_color >= rank - 3);
+}
+
+std::optional<move> next_safe_move(const board& b) noexcept
+{
+  const auto safe_target = [&](card_id c) -> pile_id
+  {
+    const pile_mask targets = target_mask(b.tops, c) & FOUNDATION_PILES;
+    return targets && is_safe_foundation_card(b, c)
+               ? static_cast<pile_id>(std::countr_zero(targets))
+               : NO_PILE;
+  };
+
+  for (const auto& t : b.tableaus)
+  {
+    const auto c = t.get_last();
+    if (c != NO_CARD)
+    {
+      const auto to = safe_target(c);
+      if (to != NO_PILE)
+      {
+        return move{
+            .moved_card = c,
+            .from_pile = t.get_id(),
+            .to_pile = to,
+            .from_position = b.cards[c].position,
+        };
+      }
+    }
+  }
+
+  // drawing several cards at once, taking one from the waste changes which
+  // cards come up on later passes
+  const auto waste = b.waste_top();
+  if (waste != NO_CARD && b.stock.draw_count == 1)
+  {
+    const auto to = safe_target(waste);
+    if (to != NO_PILE)
+    {
+      return move{
+          .moved_card = waste,
+          .from_pile = DECK_PILE,
+          .to_pile = to,
+          .from_position = b.cards[waste].position,
+      };
+    }
+  }
+
+  return std::nullopt;
+}
@@ -0,0 +1,535 @@
+#include "solver.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <thread>
+
+#include "move_generator.h"
+#include "move_rules.h"
+#include "safe_moves.h"
+#include "target_mask.h"
+
+static bool is_won(const board& b) noexcept
+{
+  return b.deck.is_empty() && (b.face_up | b.in_foundation) == card_set::all();
+}
+
+/// @brief How a deck card is brought up to the waste top
+struct stock_visit
+{
+  uint8_t advances = NO_POSITION;
+
+  /// @brief Deck cursor once it is up, see board::get_deck_cursor
+  uint16_t cursor = 0;
+};
+
+/// @brief Follows the stock through its remaining advances
+/// @return Visit of each deck position, advances is NO_POSITION for cards that
+/// never come up
+static std::array<stock_visit, PILE_CAPACITY> visit_stock(
+    const board& b) noexcept
+{
+  std::array<stock_visit, PILE_CAPACITY> visits{};
+
+  const uint8_t height = b.deck.get_height();
+  uint8_t waste = b.waste_size;
+  uint8_t passes = b.passes;
+  if (waste != 0)
+  {
+    visits[waste - 1] = stock_visit{0, b.get_deck_cursor()};
+  }
+
+  // the rest of this pass and one more cover every reachable card
+  const int max_advances = 2 * (height / b.stock.draw_count + 2);
+  for (int count = 1; count <= max_advances; count++)
+  {
+    if (waste < height)
+    {
+      waste = std::min<uint8_t>(waste + b.stock.draw_count, height);
+    }
+    else if (b.stock.pass_limit == UNLIMITED_PASSES ||
+             passes + 1 < b.stock.pass_limit)
+    {
+      passes += b.stock.pass_limit != UNLIMITED_PASSES;
+      waste = 0;
+    }
+    else
+    {
+      break;
+    }
+
+    if (waste != 0 && visits[waste - 1].advances == NO_POSITION)
+    {
+      visits[waste - 1] = stock_visit{
+          static_cast<uint8_t>(count),
+          static_cast<uint16_t>(waste |
+                                passes << board::DECK_CURSOR_PASS_SHIFT),
+      };
+    }
+  }
+
+  return visits;
+}
+
+/// @brief Step ranks, tried in this order
+enum step_rank : uint8_t
+{
+  RANK_REVEALING_TO_FOUNDATION,
+  RANK_TO_FOUNDATION,
+  RANK_REVEALING,
+  RANK_EMPTYING,
+  RANK_FROM_STOCK,
+
+  /// @brief Tableau moves that neither reveal a card nor empty a column
+  RANK_SHUFFLE,
+  RANK_FROM_FOUNDATION,
+};
+
+/// @brief Lists the steps worth trying from b, best first
+/// @param max_rank Steps of this rank and above are left out
+static uint8_t generate_steps(const board& b, uint8_t max_rank,
+                              solver::step_list& out) noexcept
+{
+  // a safe foundation move never costs a win, so nothing else needs trying
+  if (const auto safe = next_safe_move(b))
+  {
+    out[0] = solver::step{safe->moved_card, safe->to_pile, RANK_TO_FOUNDATION,
+                          0, 0};
+    return 1;
+  }
+
+  uint8_t count = 0;
+  const auto push = [&](card_id c, pile_id to, uint8_t rank,
+                        stock_visit visit = {0, 0})
+  {
+    if (rank < max_rank)
+    {
+      out[count++] = solver::step{c, to, rank, visit.advances, visit.cursor};
+    }
+  };
+
+  // empty tableaus are interchangeable, only the first one is tried
+  pile_mask targets = TABLEAU_PILES | FOUNDATION_PILES;
+  bool has_empty = false;
+  for (const auto& t : b.tableaus)
+  {
+    if (t.is_empty())
+    {
+      targets &= has_empty ? ~(1u << t.get_id()) : ~0u;
+      has_empty = true;
+    }
+  }
+
+  // tableau and foundation cards move as the move generator lists them, deck
+  // cards below with the stock advances that bring them up
+  move_list moves;
+  generate_moves(b, moves);
+  for (const auto& m : moves)
+  {
+    if (m.is_stock_advance() || m.from_pile == DECK_PILE ||
+        !(targets & 1u << m.to_pile))
+    {
+      continue;
+    }
+
+    if (type_of(m.from_pile) == pile_type::foundation)
+    {
+      push(m.moved_card, m.to_pile, RANK_FROM_FOUNDATION);
+    }
+    else if (type_of(m.to_pile) == pile_type::foundation)
+    {
+      push(m.moved_card, m.to_pile,
+           m.revealed_card ? RANK_REVEALING_TO_FOUNDATION
+                           : RANK_TO_FOUNDATION);
+    }
+    else if (m.from_position == 0)
+    {
+      // moving a whole column to an empty one changes nothing
+      if (!b.get_pile(m.to_pile).is_empty())
+      {
+        push(m.moved_card, m.to_pile, RANK_EMPTYING);
+      }
+    }
+    else
+    {
+      push(m.moved_card, m.to_pile,
+           m.revealed_card ? RANK_REVEALING : RANK_SHUFFLE);
+    }
+  }
+
+  if (!b.reachable_stock.empty())
+  {
+    std::array<card_id, PILE_CAPACITY> stock;
+    uint8_t stock_count = 0;
+    for (auto rest = b.reachable_stock; !rest.empty();)
+    {
+      stock[stock_count++] = rest.pop_first();
+    }
+    std::array<pile_mask, PILE_CAPACITY> fits;
+    target_masks(b.tops, stock.data(), stock_count, fits.data());
+
+    const auto visits = visit_stock(b);
+    for (uint8_t i = 0; i < stock_count; i++)
+    {
+      const auto c = stock[i];
+      const auto visit = visits[b.cards[c].position];
+      for (pile_mask mask = fits[i] & targets; mask; mask &= mask - 1)
+      {
+        const auto to = static_cast<pile_id>(std::countr_zero(mask));
+        push(c, to,
+             type_of(to) == pile_type::foundation ? RANK_TO_FOUNDATION
+                                                  : RANK_FROM_STOCK,
+             visit);
+      }
+    }
+  }
+
+  std::stable_sort(out.begin(), out.begin() + count,
+                   [](const solver::step& a, const solver::step& b)
+                   { return a.rank < b.rank; });
+  return count;
+}
+
+/// @brief Positions a worker expands between updates of the shared count
+constexpr uint32_t NODE_FLUSH_INTERVAL = 64;
+
+/// @brief Steps a time-sliced worker takes between looks at the clock
+constexpr uint32_t DEADLINE_CHECK_INTERVAL = 32;
+
+/// @brief Bits of a table entry that tell which pass stored it
+constexpr uint64_t GENERATION_MASK = 0xFFFF;
+
+constexpr auto NO_DEADLINE = std::chrono::steady_clock::time_point::max();
+
+solver::solver(solver_limits limits) : _limits(limits)
+{
+  _limits.threads = std::max<uint32_t>(_limits.threads, 1);
+
+  const size_t entries =
+      std::bit_ceil(std::max<uint32_t>(_limits.table_entries, 1));
+  _table = std::make_unique<std::atomic<uint64_t>[]>(entries);
+  _table_mask = entries - 1;
+
+  for (uint32_t i = 0; i < _limits.threads; i++)
+  {
+    // growing a stack of frames mid-search would copy all of it at once
+    auto& w = *_workers.emplace_back(std::make_unique<worker>());
+    w.stack.reserve(_limits.max_depth + 1);
+  }
+}
+
+solve_result solver::solve(const board& start)
+{
+  begin(start);
+
+  for (;;)
+  {
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < _workers.size(); i++)
+    {
+      threads.emplace_back([this, i] { run(i, NO_DEADLINE); });
+    }
+    run(0, NO_DEADLINE);
+    for (auto& t : threads)
+    {
+      t.join();
+    }
+
+    if (const auto result = end_pass())
+    {
+      return *result;
+    }
+  }
+}
+
+void solver::begin(const board& start)
+{
+  _start = start;
+  _result = std::nullopt;
+  _pass = 0;
+  _nodes.store(0, std::memory_order_relaxed);
+  _cancelled.store(false, std::memory_order_relaxed);
+  _won = false;
+  _line.clear();
+  _hints.clear();
+  begin_pass();
+}
+
+std::optional<solve_result> solver::resume(std::chrono::microseconds budget)
+{
+  const auto deadline = std::chrono::steady_clock::now() + budget;
+
+  // slices run on the calling thread alone; the other workers stay idle
+  while (!_result)
+  {
+    run(0, deadline);
+
+    const bool is_pass_over = _stop.load(std::memory_order_relaxed) ||
+                              _workers.front()->stack.empty();
+    if (!is_pass_over)
+    {
+      return std::nullopt;
+    }
+    _result = end_pass();
+  }
+
+  return _result;
+}
+
+void solver::begin_pass()
+{
+  // leaving out the moves that rarely help finds most wins quickly; the full
+  // search that follows settles the rest
+  _max_rank = _pass == 0 ? RANK_SHUFFLE : RANK_FROM_FOUNDATION + 1;
+  _node_budget = _pass == 0 ? _limits.max_nodes / 2 : _limits.max_nodes;
+  _out_of_budget.store(false, std::memory_order_relaxed);
+  _cut_off.store(false, std::memory_order_relaxed);
+  _stop.store(_cancelled.load(std::memory_order_relaxed),
+              std::memory_order_relaxed);
+
+  // entries of earlier passes read as free, so the table is only wiped when
+  // the generation wraps around
+  _generation = (_generation + 1) & GENERATION_MASK;
+  if (_generation == 0)
+  {
+    for (size_t i = 0; i <= _table_mask; i++)
+    {
+      _table[i].store(0, std::memory_order_relaxed);
+    }
+    _generation = 1;
+  }
+  for (auto& w : _workers)
+  {
+    w->stack.clear();
+    w->line.clear();
+    w->hints.clear();
+    w->nodes = 0;
+  }
+  _busy.store(0);
+
+  if (is_won(_start))
+  {
+    _won = true;
+    return;
+  }
+
+  // positions on the current line live on the heap: winning lines can run
+  // thousands of steps deep
+  auto& first = *_workers.front();
+  remember(_start.canonical_hash());
+  auto& root = first.stack.emplace_back(_start);
+  root.count = generate_steps(_start, _max_rank, root.steps);
+  first.nodes++;
+  _busy.store(1);
+}
+
+std::optional<solve_result> solver::end_pass()
+{
+  if (_won)
+  {
+    return solve_result::winnable;
+  }
+  if (_cancelled.load(std::memory_order_relaxed))
+  {
+    return solve_result::unknown;
+  }
+  if (_pass == 0)
+  {
+    _pass++;
+    begin_pass();
+    return std::nullopt;
+  }
+
+  const bool is_exhaustive = !_out_of_budget.load(std::memory_order_relaxed) &&
+                             !_cut_off.load(std::memory_order_relaxed);
+  return is_exhaustive ? solve_result::unwinnable : solve_result::unknown;
+}
+
+void solver::run(size_t index, std::chrono::steady_clock::time_point deadline)
+{
+  auto& w = *_workers[index];
+  bool is_busy = !w.stack.empty();
+  uint32_t steps = 0;
+
+  while (!_stop.load(std::memory_order_relaxed))
+  {
+    // reading the clock costs about as much as a step, so only every few
+    if (deadline != NO_DEADLINE && ++steps % DEADLINE_CHECK_INTERVAL == 0 &&
+        std::chrono::steady_clock::now() >= deadline)
+    {
+      break;
+    }
+
+    if (!is_busy)
+    {
+      // work only comes from busy workers: once none is left, the pass is
+      // over
+      if (_busy.load() == 0)
+      {
+        break;
+      }
+      if (steal(index))
+      {
+        is_busy = true;
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+      continue;
+    }
+
+    std::unique_lock guard(w.lock);
+    if (w.stack.empty())
+    {
+      guard.unlock();
+      _busy.fetch_sub(1);
+      is_busy = false;
+      continue;
+    }
+
+    auto& parent = w.stack.back();
+    if (parent.next == parent.count)
+    {
+      w.stack.pop_back();
+      continue;
+    }
+
+    const auto s = parent.steps[parent.next++];
+    w.line.resize(parent.line_size);
+    w.hints.resize(parent.line_size);
+    play(w, parent, s);
+  }
+
+  flush_nodes(w);
+}
+
+void solver::play(worker& w, const frame& from, const step& s)
+{
+  const auto step_hint = hint{.movable_card = s.card, .target_pile = s.to};
+
+  board next = from.position;
+  if (s.stock_advances != 0)
+  {
+    next.set_deck_cursor(s.deck_cursor);
+    w.line.insert(w.line.end(), s.stock_advances,
+                  move{.from_pile = DECK_PILE, .to_pile = DECK_PILE});
+    w.hints.insert(w.hints.end(), s.stock_advances, step_hint);
+  }
+
+  const auto& moved = next.cards[s.card];
+  w.line.push_back(move{
+      .moved_card = s.card,
+      .from_pile = moved.owner,
+      .to_pile = s.to,
+      .from_position = moved.position,
+  });
+  w.hints.push_back(step_hint);
+  w.line.back().revealed_card =
+      apply_move(next, s.card, s.to).revealed_card();
+
+  if (is_won(next))
+  {
+    std::lock_guard guard(_line_lock);
+    if (!_won)
+    {
+      _won = true;
+      _line = w.line;
+      _hints = w.hints;
+    }
+    _stop.store(true, std::memory_order_relaxed);
+    return;
+  }
+
+  const auto depth = from.depth + 1;
+  if (depth >= _limits.max_depth)
+  {
+    _cut_off.store(true, std::memory_order_relaxed);
+    return;
+  }
+  if (!remember(next.canonical_hash()))
+  {
+    return;
+  }
+
+  // from may live on this stack, so it is not used past this point
+  auto& child = w.stack.emplace_back(next);
+  child.line_size = static_cast<uint32_t>(w.line.size());
+  child.depth = depth;
+  child.count = generate_steps(next, _max_rank, child.steps);
+
+  if (++w.nodes == NODE_FLUSH_INTERVAL)
+  {
+    flush_nodes(w);
+  }
+}
+
+bool solver::steal(size_t thief)
+{
+  auto& w = *_workers[thief];
+
+  for (size_t i = 1; i < _workers.size(); i++)
+  {
+    auto& victim = *_workers[(thief + i) % _workers.size()];
+    std::scoped_lock guard(victim.lock, w.lock);
+
+    // the shallowest untried step heads the largest subtree; the victim
+    // keeps trying its frames from the front, thieves take from the back
+    for (auto& f : victim.stack)
+    {
+      if (f.next < f.count)
+      {
+        const auto s = f.steps[--f.count];
+        _busy.fetch_add(1);
+
+        w.line.assign(victim.line.begin(), victim.line.begin() + f.line_size);
+        w.hints.assign(victim.hints.begin(),
+                       victim.hints.begin() + f.line_size);
+        play(w, f, s);
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+void solver::flush_nodes(worker& w) noexcept
+{
+  const auto total = _nodes.fetch_add(w.nodes, std::memory_order_relaxed) +
+                     w.nodes;
+  w.nodes = 0;
+
+  if (total >= _node_budget)
+  {
+    _out_of_budget.store(true, std::memory_order_relaxed);
+    _stop.store(true, std::memory_order_relaxed);
+  }
+}
+
+bool solver::remember(uint64_t hash) noexcept
+{
+  // the low bits hold the generation of the pass; the slot index keeps them
+  const auto key = (hash & ~GENERATION_MASK) | _generation;
+
+  for (size_t probe = 0; probe < 8; probe++)
+  {
+    auto& slot = _table[(hash + probe) & _table_mask];
+    auto seen = slot.load(std::memory_order_relaxed);
+    while ((seen & GENERATION_MASK) != _generation)
+    {
+      if (slot.compare_exchange_weak(seen, key, std::memory_order_relaxed))
+      {
+        return true;
+      }
+    }
+    if (seen == key)
+    {
+      return false;
+    }
+  }
+
+  // the neighbourhood is full: search the position without remembering it
+  return true;
+}
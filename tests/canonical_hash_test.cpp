@@ -0,0 +1,124 @@
+// Checks that board::canonical_hash is shared by positions that differ only
+// by the order of the tableau columns and foundations, and tells apart the
+// ones that differ otherwise.
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <vector>
+
+#include "test_support.h"
+
+/// @brief Copies b with every card c replaced by relabel(c), its tableau
+/// columns and foundations shuffled
+template <typename Relabel>
+static board copy_board(const board& b, Relabel&& relabel, std::mt19937& rng)
+{
+  board copy;
+  copy.stock = b.stock;
+  copy.reset();
+
+  const auto copy_pile = [&](const pile& from, pile& to)
+  {
+    for (const auto c : from)
+    {
+      copy.place(relabel(c), to);
+      copy.set_face_up(relabel(c), b.face_up.contains(c));
+    }
+  };
+
+  std::array<uint8_t, TABLEAU_COUNT> columns;
+  std::iota(columns.begin(), columns.end(), 0);
+  std::shuffle(columns.begin(), columns.end(), rng);
+  std::array<uint8_t, FOUNDATION_COUNT> foundations;
+  std::iota(foundations.begin(), foundations.end(), 0);
+  std::shuffle(foundations.begin(), foundations.end(), rng);
+
+  copy_pile(b.deck, copy.deck);
+  for (uint8_t t = 0; t < TABLEAU_COUNT; t++)
+  {
+    copy_pile(b.tableaus[columns[t]], copy.tableaus[t]);
+  }
+  for (uint8_t f = 0; f < FOUNDATION_COUNT; f++)
+  {
+    copy_pile(b.foundations[foundations[f]], copy.foundations[f]);
+  }
+  copy.set_waste_size(b.waste_size);
+  copy.set_passes(b.passes);
+  return copy;
+}
+
+/// @brief Exact form of what canonical_hash stands for: the waste and pass
+/// counts, the deck, and the sorted tableau columns
+static std::vector<std::vector<int>> canonical_form(const board& b)
+{
+  const auto contents = [&](const pile& p)
+  {
+    std::vector<int> cards;
+    for (const auto c : p)
+    {
+      cards.push_back(c << 1 | b.face_up.contains(c));
+    }
+    return cards;
+  };
+
+  std::vector<std::vector<int>> form;
+  for (const auto& t : b.tableaus)
+  {
+    form.push_back(contents(t));
+  }
+  std::sort(form.begin(), form.end());
+  form.insert(form.begin(), contents(b.deck));
+  form.insert(form.begin(), {b.waste_size, b.passes});
+  return form;
+}
+
+static void check_position(const board& b, std::mt19937& rng)
+{
+  const auto canonical = b.canonical_hash();
+  const auto form = canonical_form(b);
+
+  const auto copy = copy_board(b, [](card_id c) { return c; }, rng);
+  CHECK(copy.hash == copy.compute_hash());
+  CHECK(copy.canonical_hash() == canonical);
+  CHECK(canonical_form(copy) == form);
+
+  // swapping the black cards of one value makes another game, unless the
+  // rest of the layout happens to mirror it
+  for (uint8_t v = 1; v <= VALUE_COUNT; v++)
+  {
+    const auto spade = card(card_suit::Spades, static_cast<card_value>(v));
+    const auto club = card(card_suit::Clubs, static_cast<card_value>(v));
+    const auto a = spade.get_id();
+    const auto c = club.get_id();
+    if (b.in_foundation.contains(a) || b.in_foundation.contains(c))
+    {
+      continue;
+    }
+
+    const auto swapped = copy_board(
+        b, [&](card_id x) { return x == a ? c : x == c ? a : x; }, rng);
+    CHECK((swapped.canonical_hash() == canonical) ==
+          (canonical_form(swapped) == form));
+  }
+}
+
+int main()
+{
+  std::mt19937 rng(23);
+  game g;
+  for (int deal = 0; deal < 60; deal++)
+  {
+    g.set_stock_rules(test_rules(deal));
+    g.new_game(deal);
+    for (int step = 0; step < 100; step++)
+    {
+      check_position(g.get_board(), rng);
+      if (!play_random_move(g, rng))
+      {
+        break;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,51 @@
+// Checks that deal numbers keep their layouts and always deal a full deck.
+
+#include <algorithm>
+#include <array>
+
+#include "deal.h"
+#include "test_support.h"
+
+/// @brief Dealing orders that must never change, or saved deal numbers would
+/// bring up other games
+static void check_known_deals()
+{
+  constexpr std::array<card_id, CARDS_COUNT> DEAL_0 = {
+      12, 35, 8,  48, 2,  49, 51, 11, 28, 25, 18, 13, 23, 41, 3,  50, 29, 14,
+      36, 0,  4,  30, 38, 44, 33, 43, 46, 24, 9,  42, 39, 32, 27, 6,  37, 17,
+      19, 26, 21, 20, 31, 16, 40, 10, 34, 7,  15, 5,  47, 1,  22, 45};
+  constexpr std::array<card_id, CARDS_COUNT> DEAL_1 = {
+      16, 3,  32, 14, 0,  40, 44, 30, 11, 48, 27, 22, 26, 12, 31, 23, 29, 50,
+      51, 6,  47, 43, 35, 33, 4,  39, 24, 1,  19, 25, 10, 42, 15, 34, 17, 2,
+      45, 5,  7,  36, 41, 49, 37, 13, 8,  20, 28, 9,  46, 21, 18, 38};
+  constexpr std::array<card_id, CARDS_COUNT> DEAL_LAST = {
+      28, 51, 42, 20, 50, 6,  17, 36, 5,  4,  45, 24, 29, 27, 9,  40, 41, 8,
+      23, 0,  7,  22, 11, 31, 16, 38, 18, 12, 32, 44, 43, 10, 19, 30, 47, 14,
+      46, 3,  25, 48, 49, 13, 37, 26, 34, 21, 2,  39, 1,  15, 35, 33};
+
+  CHECK(make_deal(0) == DEAL_0);
+  CHECK(make_deal(1) == DEAL_1);
+  CHECK(make_deal(UINT64_MAX) == DEAL_LAST);
+}
+
+int main()
+{
+  check_known_deals();
+
+  constexpr uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ull;
+  for (uint64_t deal = 0; deal < 10'000; deal++)
+  {
+    auto order = make_deal(deal);
+    std::sort(order.begin(), order.end());
+    for (card_id c = 0; c < CARDS_COUNT; c++)
+    {
+      CHECK(order[c] == c);
+    }
+
+    // deals one counter step apart do not share a stream
+    const auto rng = deal_random::for_deal(deal);
+    const auto next = deal_random::for_deal(deal + GOLDEN_GAMMA);
+    CHECK(next.at(0) != rng.at(1));
+  }
+  return EXIT_SUCCESS;
+}
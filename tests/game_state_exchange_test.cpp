@@ -0,0 +1,70 @@
+// Checks that a reader on another thread only ever sees whole snapshots, and
+// never an older one after a newer one.
+
+#include <atomic>
+#include <thread>
+
+#include "game_state_exchange.h"
+#include "test_support.h"
+
+/// @brief Snapshot whose fields, from the first to the last, all carry
+/// sequence
+static game_state make_state(uint32_t sequence)
+{
+  game_state state;
+  state.deal_number = sequence;
+  state.layout.hash = sequence * 0x9E3779B97F4A7C15ull;
+  for (auto& c : state.layout.cards)
+  {
+    c.position = static_cast<uint8_t>(sequence);
+  }
+  state.move_count = sequence;
+  return state;
+}
+
+static bool is_whole(const game_state& state)
+{
+  const auto sequence = state.move_count;
+  for (const auto& c : state.layout.cards)
+  {
+    if (c.position != static_cast<uint8_t>(sequence))
+    {
+      return false;
+    }
+  }
+  return state.deal_number == sequence &&
+         state.layout.hash == sequence * 0x9E3779B97F4A7C15ull;
+}
+
+int main()
+{
+  constexpr uint32_t LAST = 200'000;
+
+  game_state_exchange exchange;
+  exchange.publish(make_state(0));
+
+  std::atomic<bool> failed{false};
+  std::thread reader(
+      [&]
+      {
+        uint32_t seen = 0;
+        while (seen != LAST)
+        {
+          const auto& state = exchange.latest();
+          if (!is_whole(state) || state.move_count < seen)
+          {
+            failed = true;
+            return;
+          }
+          seen = state.move_count;
+        }
+      });
+
+  for (uint32_t sequence = 1; sequence <= LAST; sequence++)
+  {
+    exchange.publish(make_state(sequence));
+  }
+  reader.join();
+  CHECK(!failed);
+  return EXIT_SUCCESS;
+}
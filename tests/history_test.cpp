@@ -0,0 +1,448 @@
+// Checks that the incremental hashes, undo, redo, seek, branch switches and
+// batched moves always give the same layout and events as playing the moves
+// one at a time.
+
+#include <utility>
+#include <vector>
+
+#include "game_event_queue.h"
+#include "game_state.h"
+#include "move_rules.h"
+#include "safe_moves.h"
+#include "test_support.h"
+#include "zobrist.h"
+
+static bool same_layout(const board& a, const board& b)
+{
+  for (pile_id p = 0; p < PILE_COUNT; p++)
+  {
+    const auto& x = a.get_pile(p);
+    const auto& y = b.get_pile(p);
+    if (x.get_height() != y.get_height())
+    {
+      return false;
+    }
+    for (uint8_t i = 0; i < x.get_height(); i++)
+    {
+      if (x.at(i) != y.at(i))
+      {
+        return false;
+      }
+    }
+  }
+  return a.face_up == b.face_up && a.waste_size == b.waste_size &&
+         a.passes == b.passes && a.hash == b.hash;
+}
+
+static void check_board(const board& b)
+{
+  CHECK(b.hash == b.compute_hash());
+
+  for (pile_id p = 0; p < PILE_COUNT; p++)
+  {
+    const auto& pile = b.get_pile(p);
+    uint64_t content = 0;
+    for (uint8_t i = 0; i < pile.get_height(); i++)
+    {
+      const auto c = pile.at(i);
+      CHECK(b.cards[c].owner == p && b.cards[c].position == i);
+      CHECK(b.pile_contents[p].contains(c));
+      content ^= zobrist_content(c, i, b.face_up.contains(c));
+    }
+    CHECK(b.pile_contents[p].size() == pile.get_height());
+    CHECK(b.content_hash[p] == content);
+  }
+}
+
+static std::vector<game_event> drain(game_event_queue& events)
+{
+  std::vector<game_event> drained;
+  while (const auto e = events.pop())
+  {
+    if (e->type != game_event_type::status_changed)
+    {
+      drained.push_back(*e);
+    }
+  }
+  return drained;
+}
+
+static bool same_events(const std::vector<game_event>& a,
+                        const std::vector<game_event>& b)
+{
+  if (a.size() != b.size())
+  {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++)
+  {
+    if (a[i].type != b[i].type || a[i].card != b[i].card ||
+        a[i].from_pile != b[i].from_pile || a[i].to_pile != b[i].to_pile ||
+        a[i].position != b[i].position || a[i].depth != b[i].depth)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// @brief Plays random moves, undoing, redoing and seeking back and forth
+static void check_undo_and_seek(int deal, std::mt19937& rng)
+{
+  game g;
+  g.set_stock_rules(test_rules(deal));
+  g.new_game(deal);
+
+  for (int step = 0; step < 300; step++)
+  {
+    const board before = g.snapshot();
+    if (!play_random_move(g, rng))
+    {
+      break;
+    }
+    check_board(g.get_board());
+    const board after = g.snapshot();
+
+    if (rng() % 3 == 0)
+    {
+      g.undo_move();
+      check_board(g.get_board());
+      CHECK(same_layout(before, g.get_board()));
+      g.redo_move();
+      CHECK(same_layout(after, g.get_board()));
+    }
+
+    if (rng() % 10 == 0)
+    {
+      const auto& history = g.get_history();
+      const auto here = history.position();
+      const auto first = history.first_position();
+      const auto target =
+          first + rng() % (history.last_position() - first + 1);
+
+      g.seek(target);
+      check_board(g.get_board());
+      const board sought = g.snapshot();
+
+      g.seek(here);
+      CHECK(same_layout(after, g.get_board()));
+      while (g.get_history().position() > target)
+      {
+        g.undo_move();
+      }
+      while (g.get_history().position() < target)
+      {
+        g.redo_move();
+      }
+      CHECK(same_layout(sought, g.get_board()));
+      g.seek(here);
+    }
+  }
+}
+
+/// @brief Plays m on g as a player would
+static void play(game& g, const move& m)
+{
+  if (m.is_stock_advance())
+  {
+    g.next_deck();
+  }
+  else
+  {
+    g.move_card(m.moved_card, m.to_pile);
+  }
+}
+
+/// @brief Plays random moves, going back now and then to try another one,
+/// and jumps between the branches
+static void check_branches(int deal, std::mt19937& rng)
+{
+  game g;
+  g.set_stock_rules(test_rules(deal));
+  g.new_game(deal);
+
+  std::vector<std::pair<history_node, board>> visited;
+  for (int step = 0; step < 300; step++)
+  {
+    move_list moves;
+    generate_moves(g.get_board(), moves);
+    if (moves.empty())
+    {
+      break;
+    }
+    const auto m = moves[static_cast<uint8_t>(rng() % moves.count)];
+    play(g, m);
+    visited.emplace_back(g.get_history().current_node(), g.snapshot());
+
+    // playing a move again from the same position reuses its node
+    if (rng() % 7 == 0)
+    {
+      const auto node = g.get_history().current_node();
+      const auto nodes = g.get_history().node_count();
+      g.undo_move();
+      play(g, m);
+      CHECK(g.get_history().current_node() == node);
+      CHECK(g.get_history().node_count() == nodes);
+    }
+
+    // going back and playing on starts a new branch
+    if (rng() % 8 == 0)
+    {
+      for (auto n = rng() % 5; n > 0; n--)
+      {
+        g.undo_move();
+      }
+    }
+
+    if (rng() % 10 == 0)
+    {
+      const auto& [node, layout] = visited[rng() % visited.size()];
+      g.switch_branch(node);
+      CHECK(g.get_history().current_node() == node);
+      check_board(g.get_board());
+      CHECK(same_layout(layout, g.get_board()));
+    }
+  }
+}
+
+/// @brief Plays up to 90 random moves on scratch
+/// @return The moves played
+static std::vector<move> random_batch(board& scratch, std::mt19937& rng)
+{
+  std::vector<move> batch;
+  const int length = 1 + static_cast<int>(rng() % 90);
+  for (int i = 0; i < length; i++)
+  {
+    move_list moves;
+    generate_moves(scratch, moves);
+    if (moves.empty())
+    {
+      break;
+    }
+    const auto& m = moves[static_cast<uint8_t>(rng() % moves.count)];
+    batch.push_back(m);
+    if (m.is_stock_advance())
+    {
+      advance_deck(scratch);
+    }
+    else
+    {
+      apply_move(scratch, m.moved_card, m.to_pile);
+    }
+  }
+  return batch;
+}
+
+/// @brief Plays batches with apply_moves and the same moves one at a time
+static void check_batches(int deal, std::mt19937& rng)
+{
+  game_event_queue batched_events;
+  game_event_queue single_events;
+  game batched;
+  game single;
+  batched.set_stock_rules(test_rules(deal));
+  single.set_stock_rules(test_rules(deal));
+  batched.new_game(deal);
+  single.new_game(deal);
+  batched.set_event_queue(&batched_events);
+  single.set_event_queue(&single_events);
+
+  for (int round = 0; round < 30; round++)
+  {
+    board scratch = batched.snapshot();
+    const auto batch = random_batch(scratch, rng);
+
+    // a batch ending with an illegal move changes nothing
+    if (!batch.empty() && rng() % 4 == 0)
+    {
+      auto corrupt = batch;
+      corrupt.push_back(move{
+          .moved_card = static_cast<card_id>(rng() % CARDS_COUNT),
+          .to_pile = static_cast<pile_id>(rng() % PILE_COUNT),
+      });
+      if (!is_legal(scratch, corrupt.back()))
+      {
+        const board unchanged = batched.snapshot();
+        const auto position = batched.get_history().position();
+        CHECK(!batched.apply_moves(corrupt));
+        CHECK(same_layout(unchanged, batched.get_board()));
+        CHECK(batched.get_history().position() == position);
+      }
+    }
+
+    CHECK(batched.apply_moves(batch));
+    for (const auto& m : batch)
+    {
+      play(single, m);
+    }
+
+    check_board(batched.get_board());
+    CHECK(same_layout(scratch, batched.get_board()));
+    CHECK(same_layout(single.get_board(), batched.get_board()));
+    CHECK(batched.get_history().position() ==
+          single.get_history().position());
+    CHECK(same_events(drain(batched_events), drain(single_events)));
+
+    const auto first = batched.get_history().first_position();
+    const auto here = batched.get_history().position();
+    const auto target = first + rng() % (here - first + 1);
+    batched.seek(target);
+    single.seek(target);
+    CHECK(same_layout(single.get_board(), batched.get_board()));
+    batched.seek(here);
+    single.seek(here);
+    drain(batched_events);
+    drain(single_events);
+  }
+
+  // with auto-play on, a batch is followed by every safe move
+  batched.set_auto_play(true);
+  board scratch = batched.snapshot();
+  CHECK(batched.apply_moves(random_batch(scratch, rng)));
+  CHECK(batched.export_game_state().status != game_status::in_progress ||
+        !next_safe_move(batched.get_board()));
+}
+
+/// @brief Applies the events of g to mirror, taking the layout of g at a
+/// reset, and checks the statuses they carry
+static void follow_events(const game& g, game_event_queue& events,
+                          board& mirror, game_status& status)
+{
+  while (const auto e = events.pop())
+  {
+    switch (e->type)
+    {
+      case game_event_type::layout_reset:
+        CHECK(e->status == status);
+        mirror = g.snapshot();
+        break;
+      case game_event_type::card_moved:
+        CHECK(mirror.cards[e->card].owner == e->from_pile);
+        if (e->from_pile == DECK_PILE)
+        {
+          // the waste top leaves face up, the card below takes its place
+          mirror.set_waste_size(mirror.waste_size - 1);
+          mirror.set_face_up(e->card, true);
+        }
+        mirror.splice(e->card, mirror.get_pile(e->to_pile), e->position);
+        break;
+      case game_event_type::card_revealed:
+      case game_event_type::card_hidden:
+        mirror.set_face_up(e->card,
+                           e->type == game_event_type::card_revealed);
+        break;
+      case game_event_type::stock_cursor_changed:
+        mirror.set_waste_size(e->position);
+        mirror.set_passes(e->depth);
+        CHECK(mirror.waste_top() == e->card);
+        break;
+      case game_event_type::status_changed:
+        status = e->status;
+        break;
+    }
+  }
+}
+
+/// @brief Plays, undoes, seeks and deals with auto-play on, rebuilding a
+/// mirror of the layout from the events alone
+static void check_event_mirror(int deal, std::mt19937& rng)
+{
+  game_event_queue events;
+  game g;
+  g.set_event_queue(&events);
+  g.set_auto_play(true);
+
+  board mirror;
+  auto status = game_status::in_progress;
+  for (int step = 0; step < 400; step++)
+  {
+    if (step % 100 == 0)
+    {
+      g.set_stock_rules(test_rules(deal + step));
+      g.new_game(deal + step);
+    }
+    else if (rng() % 4 == 0)
+    {
+      g.undo_move();
+    }
+    else if (rng() % 10 == 0)
+    {
+      const auto& history = g.get_history();
+      const auto first = history.first_position();
+      g.seek(first + rng() % (history.last_position() - first + 1));
+    }
+    else
+    {
+      play_random_move(g, rng);
+    }
+
+    follow_events(g, events, mirror, status);
+    CHECK(same_layout(mirror, g.get_board()));
+    CHECK(status == g.export_game_state().status);
+  }
+}
+
+/// @brief Plays long enough for the node pool to fill up and be compacted,
+/// seeking back over the kept history now and then
+static void check_compaction(std::mt19937& rng)
+{
+  game g;
+  g.new_game(7);
+
+  // layouts of the active line by position
+  std::vector<board> layouts{g.snapshot()};
+  int compactions = 0;
+  for (int step = 0; step < 30000; step++)
+  {
+    const auto nodes = g.get_history().node_count();
+    if (rng() % 3 == 0 || !play_random_move(g, rng))
+    {
+      g.undo_move();
+      continue;
+    }
+    compactions += g.get_history().node_count() < nodes;
+
+    const auto position = g.get_history().position();
+    layouts.resize(position);
+    layouts.push_back(g.snapshot());
+
+    if (step % 500 == 0)
+    {
+      const auto& history = g.get_history();
+      const auto first = history.first_position();
+      const auto target =
+          first + rng() % (history.last_position() - first + 1);
+      g.seek(target);
+      check_board(g.get_board());
+      CHECK(same_layout(layouts[target], g.get_board()));
+      g.seek(position);
+      CHECK(same_layout(layouts[position], g.get_board()));
+    }
+  }
+  CHECK(compactions > 0);
+  CHECK(g.get_history().first_position() > 0);
+}
+
+int main()
+{
+  std::mt19937 rng(1234);
+  check_compaction(rng);
+  for (int deal = 0; deal < 100; deal++)
+  {
+    check_undo_and_seek(deal, rng);
+    check_branches(deal, rng);
+    check_batches(deal, rng);
+    check_event_mirror(deal, rng);
+  }
+
+  // copies neither publish events nor share state with the original
+  game_event_queue events;
+  game original;
+  original.set_event_queue(&events);
+  drain(events);
+  game copy = original;
+  copy.next_deck();
+  CHECK(drain(events).empty());
+  CHECK(!same_layout(copy.get_board(), original.get_board()));
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+// Checks generate_moves against is_legal tried on every card and pile, and
+// is_legal against the rules it enforces.
+
+#include <set>
+#include <utility>
+
+#include "move_rules.h"
+#include "test_support.h"
+
+static void check_moves(const board& b)
+{
+  std::set<std::pair<card_id, pile_id>> expected;
+  for (card_id c = 0; c < CARDS_COUNT; c++)
+  {
+    for (pile_id p = FIRST_TABLEAU_PILE; p < PILE_COUNT; p++)
+    {
+      const auto from = b.cards[c].owner;
+      const bool is_shuffle = type_of(from) == pile_type::foundation &&
+                              type_of(p) == pile_type::foundation;
+      if (p != from && !is_shuffle &&
+          is_legal(b, move{.moved_card = c, .to_pile = p}))
+      {
+        expected.insert({c, p});
+      }
+    }
+  }
+
+  move_list moves;
+  generate_moves(b, moves);
+
+  std::set<std::pair<card_id, pile_id>> generated;
+  bool has_advance = false;
+  for (const auto& m : moves)
+  {
+    if (m.is_stock_advance())
+    {
+      has_advance = true;
+      continue;
+    }
+
+    CHECK(generated.insert({m.moved_card, m.to_pile}).second);
+    CHECK(b.cards[m.moved_card].owner == m.from_pile);
+    CHECK(b.cards[m.moved_card].position == m.from_position);
+
+    const auto parent = b.get_parent(m.moved_card);
+    CHECK(m.revealed_card == (type_of(m.from_pile) == pile_type::tableau &&
+                              parent != NO_CARD &&
+                              !b.face_up.contains(parent)));
+  }
+
+  CHECK(generated == expected);
+  CHECK(has_advance == b.can_advance_stock());
+}
+
+static void check_buried_foundation_cards(const board& b)
+{
+  for (const auto& f : b.foundations)
+  {
+    for (uint8_t i = 0; i + 1 < f.get_height(); i++)
+    {
+      for (pile_id p = FIRST_TABLEAU_PILE; p < PILE_COUNT; p++)
+      {
+        CHECK(!is_legal(b, move{.moved_card = f.at(i), .to_pile = p}));
+      }
+    }
+  }
+}
+
+int main()
+{
+  std::mt19937 rng(5);
+  game g;
+  for (int deal = 0; deal < 200; deal++)
+  {
+    g.set_stock_rules(test_rules(deal));
+    g.new_game(deal);
+    for (int step = 0; step < 150; step++)
+    {
+      check_moves(g.get_board());
+      check_buried_foundation_cards(g.get_board());
+      if (!play_random_move(g, rng))
+      {
+        break;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,52 @@
+// Checks board::reachable_stock against the waste tops seen by advancing the
+// stock until it runs out.
+
+#include "move_rules.h"
+#include "test_support.h"
+
+static card_set advance_until_done(board b)
+{
+  card_set seen;
+  if (b.waste_top() != NO_CARD)
+  {
+    seen.insert(b.waste_top());
+  }
+
+  // every reachable card comes up within two passes
+  for (int i = 0; i < 4 * PILE_CAPACITY && b.can_advance_stock(); i++)
+  {
+    advance_deck(b);
+    if (b.waste_top() != NO_CARD)
+    {
+      seen.insert(b.waste_top());
+    }
+  }
+  return seen;
+}
+
+int main()
+{
+  std::mt19937 rng(3);
+  game g;
+  for (int deal = 0; deal < 1000; deal++)
+  {
+    g.set_stock_rules(stock_rules{
+        .draw_count = static_cast<uint8_t>(1 + deal % 4),
+        .pass_limit = static_cast<uint8_t>(deal % 5),
+    });
+    g.new_game(deal);
+    for (int step = 0; step < 150; step++)
+    {
+      CHECK(advance_until_done(g.get_board()) == g.get_board().reachable_stock);
+      if (!play_random_move(g, rng))
+      {
+        break;
+      }
+      if (rng() % 5 == 0)
+      {
+        g.undo_move();
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
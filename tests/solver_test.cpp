@@ -0,0 +1,135 @@
+// Checks that solver lines win when played, that threads and time slices
+// agree with a single-threaded solve, and that a safe move that would lose is
+// not forced.
+
+#include <chrono>
+
+#include "safe_moves.h"
+#include "solver.h"
+#include "test_support.h"
+
+/// @brief Plays a winning line and the automatic finish after it
+static void check_line(game g, const solver& s)
+{
+  CHECK(s.get_solution().size() == s.get_solution_hints().size());
+  CHECK(g.apply_moves(s.get_solution()));
+
+  for (int i = 0; i < CARDS_COUNT; i++)
+  {
+    const auto m = g.next_auto_move();
+    if (!m)
+    {
+      break;
+    }
+    g.move_card(m->moved_card, m->to_pile);
+  }
+  CHECK(g.get_counters().foundation_cards == CARDS_COUNT);
+}
+
+/// @brief Black suits done, hearts up to the queen, diamonds up to the ace,
+/// the other diamonds face up on the tableaus. The deck holds the king of
+/// hearts, then the 3, 2 and 4 of diamonds, with the king on the waste.
+/// Putting the safe king up first leaves the 2 out of reach in draw three,
+/// but dealing on to the 2 wins.
+static board draw_three_trap()
+{
+  board b;
+  b.stock = DRAW_THREE;
+  b.reset();
+
+  const auto build = [&](card_suit suit, card_value last)
+  {
+    auto& foundation = b.foundations[static_cast<uint8_t>(suit)];
+    for (uint8_t v = 1; v <= static_cast<uint8_t>(last); v++)
+    {
+      const auto c = card(suit, static_cast<card_value>(v)).get_id();
+      b.place(c, foundation);
+      b.set_face_up(c, true);
+    }
+  };
+  build(card_suit::Spades, card_value::King);
+  build(card_suit::Clubs, card_value::King);
+  build(card_suit::Hearths, card_value::Queen);
+  build(card_suit::Diamonds, card_value::Ace);
+
+  // lower cards on top, so they go up without tableau moves
+  for (uint8_t v = 13; v >= 5; v--)
+  {
+    const auto c =
+        card(card_suit::Diamonds, static_cast<card_value>(v)).get_id();
+    b.place(c, b.tableaus[(v - 5) % TABLEAU_COUNT]);
+    b.set_face_up(c, true);
+  }
+
+  for (const auto& [suit, value] : {
+           std::pair{card_suit::Hearths, card_value::King},
+           std::pair{card_suit::Diamonds, static_cast<card_value>(3)},
+           std::pair{card_suit::Diamonds, static_cast<card_value>(2)},
+           std::pair{card_suit::Diamonds, static_cast<card_value>(4)},
+       })
+  {
+    b.place(card(suit, value).get_id(), b.deck);
+  }
+  b.set_waste_size(1);
+  return b;
+}
+
+int main()
+{
+  const solver_limits limits{.max_nodes = 100'000, .table_entries = 1u << 18};
+  solver single(limits);
+  solver sliced(limits);
+
+  auto threaded_limits = limits;
+  threaded_limits.threads = 4;
+  solver threaded(threaded_limits);
+
+  int won = 0;
+  game g;
+  for (int deal = 0; deal < 12; deal++)
+  {
+    g.set_stock_rules(test_rules(deal));
+    g.new_game(deal);
+    const auto& start = g.get_board();
+
+    const auto result = single.solve(start);
+    if (result == solve_result::winnable)
+    {
+      check_line(g, single);
+      won++;
+    }
+
+    // a slice at a time on one thread searches the same tree
+    sliced.begin(start);
+    std::optional<solve_result> sliced_result;
+    while (!sliced_result)
+    {
+      sliced_result = sliced.resume(std::chrono::microseconds(200));
+    }
+    CHECK(*sliced_result == result);
+    if (result == solve_result::winnable)
+    {
+      check_line(g, sliced);
+    }
+
+    // threads may find another line, or none before the budget runs out
+    const auto threaded_result = threaded.solve(start);
+    CHECK(result != solve_result::unwinnable ||
+          threaded_result != solve_result::winnable);
+    if (threaded_result == solve_result::winnable)
+    {
+      check_line(g, threaded);
+    }
+  }
+  CHECK(won > 0);
+
+  // the waste top is not forced when the draw rules make it costly
+  const auto trap = draw_three_trap();
+  CHECK(!next_safe_move(trap));
+  CHECK(single.solve(trap) == solve_result::winnable);
+
+  game trapped;
+  trapped.restore(trap);
+  check_line(trapped, single);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,61 @@
+// Checks the packed tops and target_mask against the follower tables, pile
+// by pile, as the board changes.
+
+#include "test_support.h"
+
+static void check_masks(const board& b)
+{
+  target_tops fresh;
+  for (pile_id p = FIRST_TABLEAU_PILE; p < PILE_COUNT; p++)
+  {
+    fresh.set(p, b.get_pile(p).type, b.get_pile(p).get_last());
+  }
+  CHECK(fresh.want == b.tops.want && fresh.care == b.tops.care);
+
+  std::array<card_id, CARDS_COUNT> cards;
+  std::array<pile_mask, CARDS_COUNT> masks;
+  for (card_id c = 0; c < CARDS_COUNT; c++)
+  {
+    cards[c] = c;
+  }
+  target_masks(b.tops, cards.data(), CARDS_COUNT, masks.data());
+
+  for (card_id c = 0; c < CARDS_COUNT; c++)
+  {
+    pile_mask expected = 0;
+    for (pile_id p = FIRST_TABLEAU_PILE; p < PILE_COUNT; p++)
+    {
+      const auto& target = b.get_pile(p);
+      if (valid_followers(target.type, target.get_last()).contains(c))
+      {
+        expected |= 1u << p;
+      }
+    }
+    CHECK(target_mask(b.tops, c) == expected);
+    CHECK(masks[c] == expected);
+  }
+}
+
+int main()
+{
+  std::mt19937 rng(9);
+  game g;
+  for (int deal = 0; deal < 200; deal++)
+  {
+    g.set_stock_rules(test_rules(deal));
+    g.new_game(deal);
+    for (int step = 0; step < 200; step++)
+    {
+      check_masks(g.get_board());
+      if (!play_random_move(g, rng))
+      {
+        break;
+      }
+      if (rng() % 6 == 0)
+      {
+        g.undo_move();
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "game.h"
+#include "move_generator.h"
+
+/// @brief Stops the test with the failed condition and its location
+#define CHECK(condition)                                                   \
+  do                                                                       \
+  {                                                                        \
+    if (!(condition))                                                      \
+    {                                                                      \
+      std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, \
+                   #condition);                                            \
+      std::exit(EXIT_FAILURE);                                             \
+    }                                                                      \
+  } while (false)
+
+/// @brief Stock rules cycled through by the tests: both draw counts, with
+/// and without pass limits
+inline stock_rules test_rules(int index) noexcept
+{
+  return stock_rules{
+      .draw_count = static_cast<uint8_t>(index % 2 ? 3 : 1),
+      .pass_limit = static_cast<uint8_t>(index % 3),
+  };
+}
+
+/// @brief Plays a random legal move
+/// @return false if there was none
+inline bool play_random_move(game& g, std::mt19937& rng) noexcept
+{
+  move_list moves;
+  generate_moves(g.get_board(), moves);
+  if (moves.empty())
+  {
+    return false;
+  }
+
+  const auto& m = moves[static_cast<uint8_t>(rng() % moves.count)];
+  if (m.is_stock_advance())
+  {
+    g.next_deck();
+  }
+  else
+  {
+    g.move_card(m.moved_card, m.to_pile);
+  }
+  return true;
+}